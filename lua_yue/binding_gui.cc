@@ -4,13 +4,17 @@
 
 #include "lua_yue/binding_gui.h"
 
+#include <string.h>
+
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "base/command_line.h"
 #include "lua_yue/binding_signal.h"
+#include "nativeui/gfx/geometry/rect_conversions.h"
 #include "nativeui/nativeui.h"
 
 namespace lua {
@@ -162,7 +166,8 @@ struct Type<nu::Lifetime> {
            "run", &nu::Lifetime::Run,
            "quit", &nu::Lifetime::Quit,
            "posttask", &nu::Lifetime::PostTask,
-           "postdelayedtask", &nu::Lifetime::PostDelayedTask);
+           "postdelayedtask", &nu::Lifetime::PostDelayedTask,
+           "postidletask", &nu::Lifetime::PostIdleTask);
     RawSetProperty(state, index, "onready", &nu::Lifetime::on_ready);
   }
 };
@@ -182,6 +187,20 @@ struct Type<nu::App::ThemeColor> {
   }
 };
 
+template<>
+struct Type<nu::LayoutStats> {
+  static constexpr const char* name = "yue.LayoutStats";
+  static inline void Push(State* state, const nu::LayoutStats& stats) {
+    lua::NewTable(state);
+    lua::RawSet(state, -1,
+                "layoutpasses", stats.layout_passes,
+                "nodesvisited", stats.nodes_visited,
+                "measurecalls", stats.measure_calls,
+                "boundschanges", stats.bounds_changes,
+                "layouttime", stats.layout_time.InMillisecondsF());
+  }
+};
+
 template<>
 struct Type<nu::App> {
   static constexpr const char* name = "yue.App";
@@ -191,7 +210,9 @@ struct Type<nu::App> {
            "setapplicationmenu", &nu::App::SetApplicationMenu,
 #endif
            "getcolor", &nu::App::GetColor,
-           "getdefaultfont", &nu::App::GetDefaultFont);
+           "getdefaultfont", &nu::App::GetDefaultFont,
+           "getlayoutstats", &nu::App::GetLayoutStats,
+           "resetlayoutstats", &nu::App::ResetLayoutStats);
   }
 };
 
@@ -295,24 +316,236 @@ struct Type<nu::Font::Style> {
   }
 };
 
+template<>
+struct Type<nu::FontMetrics> {
+  static constexpr const char* name = "yue.FontMetrics";
+  static inline void Push(State* state, const nu::FontMetrics& metrics) {
+    NewTable(state, 0, 3);
+    RawSet(state, -1,
+           "ascent", metrics.ascent,
+           "descent", metrics.descent,
+           "averagecharwidth", metrics.average_char_width);
+  }
+};
+
 template<>
 struct Type<nu::Font> {
   static constexpr const char* name = "yue.Font";
   static void BuildMetaTable(State* state, int index) {
     RawSet(state, index,
-           "create", &CreateOnHeap<nu::Font, const std::string&, float,
-                                   nu::Font::Weight, nu::Font::Style>,
+           "create", &Create,
            "default", &GetDefault,
            "getname", &nu::Font::GetName,
            "getsize", &nu::Font::GetSize,
            "getweight", &nu::Font::GetWeight,
-           "getstyle", &nu::Font::GetStyle);
+           "getstyle", &nu::Font::GetStyle,
+           "getmetrics", &nu::Font::GetMetrics);
+  }
+  // Fonts with the same specs are shared.
+  static nu::Font* Create(const std::string& name, float size,
+                          nu::Font::Weight weight, nu::Font::Style style) {
+    return nu::State::GetCurrent()->font_registry()->GetFont(
+        name, size, weight, style);
   }
   static nu::Font* GetDefault() {
     return nu::App::GetCurrent()->GetDefaultFont();
   }
 };
 
+// Read the styles table, numbers are passed as numbers instead of strings.
+void ReadStyleSheet(State* state, int index, nu::StyleSheet* style) {
+  if (GetType(state, index) != LuaType::Table)
+    return;
+  StackAutoReset reset(state);
+  PushNil(state);
+  while (lua_next(state, index) != 0) {
+    std::string name;
+    if (GetType(state, -2) == LuaType::String && To(state, -2, &name)) {
+      float number;
+      std::string value;
+      if (GetType(state, -1) == LuaType::Number && To(state, -1, &number))
+        style->SetProperty(name, number);
+      else if (To(state, -1, &value))
+        style->SetProperty(name, value);
+    }
+    PopAndIgnore(state, 1);
+  }
+}
+
+template<>
+struct Type<nu::StyleSheet> {
+  static constexpr const char* name = "yue.StyleSheet";
+  static void BuildMetaTable(State* state, int index) {
+    RawSet(state, index,
+           "create", &Create,
+           "setproperty", &SetProperty,
+           "size", &nu::StyleSheet::size);
+  }
+  static nu::StyleSheet* Create(CallContext* context) {
+    nu::StyleSheet* style = new nu::StyleSheet;
+    ReadStyleSheet(context->state, 1, style);
+    return style;
+  }
+  static bool SetProperty(CallContext* context, nu::StyleSheet* style,
+                          const std::string& name) {
+    float number;
+    std::string value;
+    if (GetType(context->state, 3) == LuaType::Number &&
+        To(context->state, 3, &number))
+      return style->SetProperty(name, number);
+    else if (To(context->state, 3, &value))
+      return style->SetProperty(name, value);
+    return false;
+  }
+};
+
+// Read painter commands from an array of numbers, or from a string of packed
+// floats created by string.pack.
+bool ReadPainterCommands(State* state, int index, std::vector<float>* out) {
+  if (GetType(state, index) == LuaType::String) {
+    size_t length;
+    const char* data = lua_tolstring(state, index, &length);
+    if (length % sizeof(float) != 0)
+      return false;
+    out->resize(length / sizeof(float));
+    memcpy(out->data(), data, length);
+    return true;
+  }
+  if (GetType(state, index) != LuaType::Table)
+    return false;
+  size_t length = RawLen(state, index);
+  out->resize(length);
+  for (size_t i = 0; i < length; ++i) {
+    RawGet(state, index, static_cast<int>(i + 1));
+    bool success = To(state, -1, &(*out)[i]);
+    PopAndIgnore(state, 1);
+    if (!success)
+      return false;
+  }
+  return true;
+}
+
+template<>
+struct Type<nu::PainterCommandBuffer> {
+  static constexpr const char* name = "yue.PainterCommandBuffer";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "create", &CreateOnHeap<nu::PainterCommandBuffer>,
+           "append", &Append,
+           "clear", &nu::PainterCommandBuffer::Clear,
+           "size", &nu::PainterCommandBuffer::size);
+  }
+  static void Append(CallContext* context,
+                     nu::PainterCommandBuffer* buffer) {
+    std::vector<float> commands;
+    if (!ReadPainterCommands(context->state, 2, &commands)) {
+      context->has_error = true;
+      Push(context->state, "Commands must be array of numbers or string");
+      return;
+    }
+    buffer->Append(commands.data(), commands.size());
+  }
+};
+
+// The locked pixels of canvas, which are unlocked when calling unlock or when
+// garbage collected.
+class CanvasPixels : public base::RefCounted<CanvasPixels> {
+ public:
+  explicit CanvasPixels(nu::Canvas* canvas)
+      : canvas_(canvas), pixels_(canvas->LockPixels()) {}
+
+  // Return the address of pixel at (|x|, |y|), or nullptr if it is out of
+  // range or the pixels have been unlocked.
+  uint32_t* GetPixel(int x, int y) const {
+    if (!canvas_ || x < 0 || y < 0 || x >= pixels_.width ||
+        y >= pixels_.height)
+      return nullptr;
+    return reinterpret_cast<uint32_t*>(pixels_.data + y * pixels_.stride) + x;
+  }
+
+  void Unlock(const nu::Rect& dirty) {
+    if (!canvas_)
+      return;
+    canvas_->UnlockPixels(dirty);
+    canvas_ = nullptr;
+  }
+
+  int width() const { return pixels_.width; }
+  int height() const { return pixels_.height; }
+  int stride() const { return pixels_.stride; }
+
+ private:
+  friend class base::RefCounted<CanvasPixels>;
+
+  ~CanvasPixels() {
+    if (canvas_)
+      canvas_->UnlockPixels();
+  }
+
+  scoped_refptr<nu::Canvas> canvas_;
+  nu::Canvas::PixelBuffer pixels_;
+};
+
+template<>
+struct Type<nu::Path> {
+  static constexpr const char* name = "yue.Path";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "create", &CreateOnHeap<nu::Path>,
+           "moveto", &nu::Path::MoveTo,
+           "lineto", &nu::Path::LineTo,
+           "beziercurveto", &nu::Path::BezierCurveTo,
+           "arc", &nu::Path::Arc,
+           "rect", &nu::Path::Rect,
+           "closepath", &nu::Path::ClosePath,
+           "clear", &nu::Path::Clear,
+           "getbounds", &nu::Path::GetBounds);
+  }
+};
+
+template<>
+struct Type<CanvasPixels> {
+  static constexpr const char* name = "yue.CanvasPixels";
+  static void BuildMetaTable(State* state, int index) {
+    RawSet(state, index,
+           "get", &Get,
+           "set", &Set,
+           "unlock", &Unlock,
+           "getwidth", &CanvasPixels::width,
+           "getheight", &CanvasPixels::height,
+           "getstride", &CanvasPixels::stride);
+  }
+  static uint32_t Get(CallContext* context, CanvasPixels* pixels,
+                      int x, int y) {
+    uint32_t* pixel = pixels->GetPixel(x, y);
+    if (!pixel) {
+      context->has_error = true;
+      Push(context->state, "Pixel is out of range or unlocked");
+      return 0;
+    }
+    return *pixel;
+  }
+  static void Set(CallContext* context, CanvasPixels* pixels,
+                  int x, int y, uint32_t value) {
+    uint32_t* pixel = pixels->GetPixel(x, y);
+    if (!pixel) {
+      context->has_error = true;
+      Push(context->state, "Pixel is out of range or unlocked");
+      return;
+    }
+    *pixel = value;
+  }
+  static void Unlock(CallContext* context, CanvasPixels* pixels) {
+    nu::RectF dirty(0, 0, pixels->width(), pixels->height());
+    if (GetTop(context->state) > 1 && !To(context->state, 2, &dirty)) {
+      context->has_error = true;
+      Push(context->state, "Dirty area must be a rectangle");
+      return;
+    }
+    pixels->Unlock(nu::ToEnclosingRect(dirty));
+  }
+};
+
 template<>
 struct Type<nu::Canvas> {
   static constexpr const char* name = "yue.Canvas";
@@ -322,7 +555,56 @@ struct Type<nu::Canvas> {
            "createformainscreen", &CreateOnHeap<nu::Canvas, const nu::SizeF&>,
            "getscalefactor", &nu::Canvas::GetScaleFactor,
            "getpainter", &nu::Canvas::GetPainter,
-           "getsize", &nu::Canvas::GetSize);
+           "getsize", &nu::Canvas::GetSize,
+           "lockpixels", &LockPixels,
+           "ispixelslocked", &nu::Canvas::IsPixelsLocked,
+           "paintasync", &PaintAsync,
+           "ispainting", &nu::Canvas::IsPainting);
+  }
+  // Lua can not run on the worker thread, so the painting is described by
+  // commands, which are copied and validated before painting starts.
+  static void PaintAsync(CallContext* context, nu::Canvas* canvas) {
+    auto commands = std::make_shared<std::vector<float>>();
+    nu::PainterCommandBuffer* buffer;
+    if (To(context->state, 2, &buffer)) {
+      commands->assign(buffer->data(), buffer->data() + buffer->size());
+    } else if (!ReadPainterCommands(context->state, 2, commands.get())) {
+      context->has_error = true;
+      Push(context->state,
+           "Commands must be PainterCommandBuffer, array or string");
+      return;
+    }
+    std::function<void()> done;
+    if (GetTop(context->state) > 2 && !To(context->state, 3, &done)) {
+      context->has_error = true;
+      Push(context->state, "The callback must be a function");
+      return;
+    }
+    if (canvas->IsPainting() || canvas->IsPixelsLocked()) {
+      context->has_error = true;
+      Push(context->state, "Canvas is being painted or locked");
+      return;
+    }
+    std::string error;
+    if (!nu::PainterCommandBuffer::Validate(commands->data(), commands->size(),
+                                            &error)) {
+      context->has_error = true;
+      Push(context->state, error);
+      return;
+    }
+    canvas->PaintAsync([commands](nu::Painter* painter) {
+      std::string error;
+      nu::PainterCommandBuffer::Replay(painter, commands->data(),
+                                       commands->size(), &error);
+    }, done);
+  }
+  static CanvasPixels* LockPixels(CallContext* context, nu::Canvas* canvas) {
+    if (canvas->IsPixelsLocked()) {
+      context->has_error = true;
+      Push(context->state, "Pixels are already locked");
+      return nullptr;
+    }
+    return new CanvasPixels(canvas);
   }
 };
 
@@ -362,8 +644,71 @@ struct Type<nu::Image> {
   static void BuildMetaTable(State* state, int index) {
     RawSet(state, index,
            "createfrompath", &CreateOnHeap<nu::Image, const base::FilePath&>,
+           "createfrompathasync", &CreateFromPathAsync,
+           "createfrombuffer", &CreateFromBuffer,
+           "createfrombase64", &CreateFromBase64,
+           "createfrommappedfile", &CreateFromMappedFile,
+           "createfrompathatsize", &CreateFromPathAtSize,
            "getsize", &nu::Image::GetSize,
-           "getscalefactor", &nu::Image::GetScaleFactor);
+           "getscalefactor", &nu::Image::GetScaleFactor,
+           "setmipmapped", &nu::Image::SetMipmapped,
+           "ismipmapped", &nu::Image::IsMipmapped);
+  }
+  // The data is read from the string directly without copying.
+  static nu::Image* CreateFromBuffer(CallContext* context) {
+    float scale_factor = 1.f;
+    if (GetType(context->state, 1) != LuaType::String ||
+        (GetTop(context->state) > 1 &&
+         !To(context->state, 2, &scale_factor))) {
+      Push(context->state, "Expect a string and an optional scale factor");
+      context->has_error = true;
+      return nullptr;
+    }
+    size_t length;
+    const char* data = lua_tolstring(context->state, 1, &length);
+    return CheckDecoded(context,
+                        nu::Image::CreateFromBuffer(data, length,
+                                                    scale_factor));
+  }
+  static nu::Image* CreateFromBase64(CallContext* context,
+                                     const std::string& data) {
+    float scale_factor = 1.f;
+    if (GetTop(context->state) > 1 && !To(context->state, 2, &scale_factor)) {
+      Push(context->state, "Scale factor must be a number");
+      context->has_error = true;
+      return nullptr;
+    }
+    return CheckDecoded(context,
+                        nu::Image::CreateFromBase64(data, scale_factor));
+  }
+  static nu::Image* CreateFromMappedFile(CallContext* context,
+                                         const base::FilePath& path) {
+    return CheckDecoded(context, nu::Image::CreateFromMappedFile(path));
+  }
+  static nu::Image* CreateFromPathAtSize(CallContext* context,
+                                         const base::FilePath& path,
+                                         const nu::SizeF& size,
+                                         float scale_factor) {
+    return CheckDecoded(
+        context, nu::Image::CreateFromPathAtSize(path, size, scale_factor));
+  }
+  static nu::Image* CheckDecoded(CallContext* context, nu::Image* image) {
+    if (!image) {
+      Push(context->state, "Failed to decode image");
+      context->has_error = true;
+    }
+    return image;
+  }
+  static void CreateFromPathAsync(
+      CallContext* context,
+      const base::FilePath& path,
+      const std::function<void(nu::Image*)>& callback) {
+    if (!callback) {
+      Push(context->state, "The callback must be a function");
+      context->has_error = true;
+      return;
+    }
+    nu::Image::CreateFromPathAsync(path, callback);
   }
 };
 
@@ -416,6 +761,7 @@ struct Type<nu::Painter> {
   static constexpr const char* name = "yue.Painter";
   static void BuildMetaTable(State* state, int metatable) {
     RawSet(state, metatable,
+           "execute", &Execute,
            "save", &nu::Painter::Save,
            "restore", &nu::Painter::Restore,
            "beginpath", &nu::Painter::BeginPath,
@@ -427,6 +773,7 @@ struct Type<nu::Painter> {
            "rect", &nu::Painter::Rect,
            "clip", &nu::Painter::Clip,
            "cliprect", &nu::Painter::ClipRect,
+           "quickreject", &nu::Painter::QuickReject,
            "translate", &nu::Painter::Translate,
            "rotate", &nu::Painter::Rotate,
            "scale", &nu::Painter::Scale,
@@ -436,6 +783,9 @@ struct Type<nu::Painter> {
            "setlinewidth", &nu::Painter::SetLineWidth,
            "stroke", &nu::Painter::Stroke,
            "fill", &nu::Painter::Fill,
+           "strokepath", &nu::Painter::StrokePath,
+           "fillpath", &nu::Painter::FillPath,
+           "clippath", &nu::Painter::ClipPath,
            "strokerect", &nu::Painter::StrokeRect,
            "fillrect", &nu::Painter::FillRect,
            "drawimage", &nu::Painter::DrawImage,
@@ -445,6 +795,23 @@ struct Type<nu::Painter> {
            "measuretext", &nu::Painter::MeasureText,
            "drawtext", &nu::Painter::DrawText);
   }
+  static void Execute(CallContext* context, nu::Painter* painter) {
+    std::string error;
+    nu::PainterCommandBuffer* buffer;
+    std::vector<float> commands;
+    if (To(context->state, 2, &buffer)) {
+      if (buffer->Replay(painter, &error))
+        return;
+    } else if (ReadPainterCommands(context->state, 2, &commands)) {
+      if (nu::PainterCommandBuffer::Replay(painter, commands.data(),
+                                           commands.size(), &error))
+        return;
+    } else {
+      error = "Commands must be PainterCommandBuffer, array or string";
+    }
+    context->has_error = true;
+    Push(context->state, error);
+  }
 };
 
 template<>
@@ -933,9 +1300,18 @@ struct Type<nu::Window> {
 #endif
            "settitle", &nu::Window::SetTitle,
            "gettitle", &nu::Window::GetTitle,
+           "setdeferredlayout", &nu::Window::SetDeferredLayout,
+           "isdeferredlayout", &nu::Window::IsDeferredLayout,
+           "setasynclayout", &nu::Window::SetAsyncLayout,
+           "isasynclayout", &nu::Window::IsAsyncLayout,
+           "flushlayout", &nu::Window::FlushLayout,
+           "getlayoutstats", &nu::Window::GetLayoutStats,
+           "resetlayoutstats", &nu::Window::ResetLayoutStats,
+           "requestframe", &nu::Window::RequestFrame,
            "setbackgroundcolor", &nu::Window::SetBackgroundColor);
     RawSetProperty(state, metatable,
                    "onclose", &nu::Window::on_close,
+                   "onframe", &nu::Window::on_frame,
                    "shouldclose", &nu::Window::should_close);
   }
 };
@@ -951,6 +1327,7 @@ struct Type<nu::View> {
            "getbounds", &nu::View::GetBounds,
            "layout", &nu::View::Layout,
            "schedulepaint", &nu::View::SchedulePaint,
+           "schedulepaintrect", &nu::View::SchedulePaintRect,
            "setvisible", &nu::View::SetVisible,
            "isvisible", &nu::View::IsVisible,
            "focus", &nu::View::Focus,
@@ -966,7 +1343,9 @@ struct Type<nu::View> {
            "setcolor", &nu::View::SetColor,
            "setbackgroundcolor", &nu::View::SetBackgroundColor,
            "setstyle", &SetStyle,
+           "applystyle", &nu::View::ApplyStyle,
            "printstyle", &nu::View::PrintStyle,
+           "dumplayouttree", &nu::View::DumpLayoutTree,
            "getminimumsize", &nu::View::GetMinimumSize,
            "getparent", &nu::View::GetParent,
            "getwindow", &nu::View::GetWindow);
@@ -981,11 +1360,10 @@ struct Type<nu::View> {
                    "onsizechanged", &nu::View::on_size_changed,
                    "oncapturelost", &nu::View::on_capture_lost);
   }
-  static void SetStyle(nu::View* view,
-                       const std::map<std::string, std::string>& styles) {
-    for (const auto& it : styles)
-      view->SetStyleProperty(it.first, it.second);
-    view->Layout();
+  static void SetStyle(CallContext* context, nu::View* view) {
+    scoped_refptr<nu::StyleSheet> style(new nu::StyleSheet);
+    ReadStyleSheet(context->state, 2, style.get());
+    view->ApplyStyle(style.get());
   }
 };
 
@@ -1004,6 +1382,17 @@ struct Type<nu::Container> {
            "addchildview", &nu::Container::AddChildView,
            "addchildviewat", &AddChildViewAt,
            "removechildview", &nu::Container::RemoveChildView,
+           "addchildviews", &nu::Container::AddChildViews,
+           "removeallchildviews", &nu::Container::RemoveAllChildViews,
+           "replacechildviews", &nu::Container::ReplaceChildViews,
+           "movechildview", &MoveChildView,
+           "beginupdate", &nu::Container::BeginUpdate,
+           "endupdate", &nu::Container::EndUpdate,
+           "setcacheddrawing", &nu::Container::SetCachedDrawing,
+           "iscacheddrawing", &nu::Container::IsCachedDrawing,
+           "settileddrawing", &nu::Container::SetTiledDrawing,
+           "istileddrawing", &nu::Container::IsTiledDrawing,
+           "settilememorylimit", &SetTileMemoryLimit,
            "childcount", &nu::Container::ChildCount,
            "childat", &ChildAt);
     RawSetProperty(state, index, "ondraw", &nu::Container::on_draw);
@@ -1012,9 +1401,16 @@ struct Type<nu::Container> {
   static inline void AddChildViewAt(nu::Container* c, nu::View* view, int i) {
     c->AddChildViewAt(view, i - 1);
   }
+  static inline void MoveChildView(nu::Container* c, nu::View* view, int i) {
+    c->MoveChildView(view, i - 1);
+  }
   static inline nu::View* ChildAt(nu::Container* container, int i) {
     return container->ChildAt(i - 1);
   }
+  static inline void SetTileMemoryLimit(nu::Container* container,
+                                        uint32_t bytes) {
+    container->SetTileMemoryLimit(bytes);
+  }
 };
 
 template<>
@@ -1172,7 +1568,9 @@ struct Type<nu::Label> {
     RawSet(state, metatable,
            "create", &CreateOnHeap<nu::Label, const std::string&>,
            "settext", &nu::Label::SetText,
-           "gettext", &nu::Label::GetText);
+           "gettext", &nu::Label::GetText,
+           "setwrapping", &nu::Label::SetWrapping,
+           "iswrapping", &nu::Label::IsWrapping);
   }
 };
 
@@ -1380,10 +1778,13 @@ extern "C" int luaopen_yue_gui(lua::State* state) {
   BindType<nu::Lifetime>(state, "Lifetime");
   BindType<nu::App>(state, "App");
   BindType<nu::Font>(state, "Font");
+  BindType<nu::StyleSheet>(state, "StyleSheet");
   BindType<nu::Canvas>(state, "Canvas");
   BindType<nu::Color>(state, "Color");
   BindType<nu::Image>(state, "Image");
   BindType<nu::Painter>(state, "Painter");
+  BindType<nu::PainterCommandBuffer>(state, "PainterCommandBuffer");
+  BindType<nu::Path>(state, "Path");
   BindType<nu::Event>(state, "Event");
   BindType<nu::FileDialog>(state, "FileDialog");
   BindType<nu::FileOpenDialog>(state, "FileOpenDialog");
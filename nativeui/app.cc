@@ -4,7 +4,6 @@
 
 #include "nativeui/app.h"
 
-#include "nativeui/gfx/font.h"
 #include "nativeui/menu_bar.h"
 #include "nativeui/state.h"
 
@@ -19,8 +18,6 @@ App::App() : weak_factory_(this) {
 }
 
 App::~App() {
-  // The GUI members must be destroyed before we shutdown GUI engine.
-  default_font_ = nullptr;
 }
 
 Color App::GetColor(ThemeColor name) {
@@ -34,9 +31,15 @@ Color App::GetColor(ThemeColor name) {
 }
 
 Font* App::GetDefaultFont() {
-  if (!default_font_)
-    default_font_ = new Font;
-  return default_font_.get();
+  return State::GetCurrent()->font_registry()->GetDefaultFont();
+}
+
+LayoutStats App::GetLayoutStats() const {
+  return *State::GetCurrent()->layout_stats();
+}
+
+void App::ResetLayoutStats() {
+  *State::GetCurrent()->layout_stats() = LayoutStats();
 }
 
 }  // namespace nu
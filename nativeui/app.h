@@ -9,6 +9,7 @@
 
 #include "base/memory/weak_ptr.h"
 #include "nativeui/gfx/color.h"
+#include "nativeui/layout_stats.h"
 
 namespace nu {
 
@@ -31,6 +32,10 @@ class NATIVEUI_EXPORT App {
   // Return the default GUI font.
   Font* GetDefaultFont();
 
+  // Return the counters of layout work done in all windows since last reset.
+  LayoutStats GetLayoutStats() const;
+  void ResetLayoutStats();
+
 #if defined(OS_MACOSX)
   // Set the application menu.
   void SetApplicationMenu(MenuBar* menu);
@@ -51,8 +56,6 @@ class NATIVEUI_EXPORT App {
   // Cached theme colors.
   std::unordered_map<int, Color> theme_colors_;
 
-  scoped_refptr<Font> default_font_;
-
 #if defined(OS_MACOSX)
   scoped_refptr<MenuBar> application_menu_;
 #endif
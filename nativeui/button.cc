@@ -26,4 +26,12 @@ const char* Button::GetClassName() const {
   return kClassName;
 }
 
+SizeF Button::Measure(float width) const {
+  // The title is clipped when the button is given less width than it needs.
+  SizeF size = GetMinimumSize();
+  if (width >= 0 && size.width() > width)
+    size.set_width(width);
+  return size;
+}
+
 }  // namespace nu
@@ -60,6 +60,7 @@ class NATIVEUI_EXPORT Button : public View {
   // View:
   const char* GetClassName() const override;
   SizeF GetMinimumSize() const override;
+  SizeF Measure(float width) const override;
 
   // Events.
   Signal<void(Button*)> on_click;
@@ -79,3 +79,12 @@ TEST_F(ButtonTest, RadioGroup) {
   EXPECT_TRUE(r2->IsChecked());
   EXPECT_FALSE(r3->IsChecked());
 }
+
+TEST_F(ButtonTest, MeasureRespectsWidth) {
+  scoped_refptr<nu::Button> button = new nu::Button("some long title");
+  nu::SizeF size = button->GetMinimumSize();
+  EXPECT_EQ(button->Measure(-1), size);
+  EXPECT_EQ(button->Measure(size.width() + 10), size);
+  EXPECT_EQ(button->Measure(size.width() / 2),
+            nu::SizeF(size.width() / 2, size.height()));
+}
@@ -5,9 +5,20 @@
 #include "nativeui/container.h"
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
+#include <utility>
 
 #include "base/logging.h"
+#include "nativeui/gfx/canvas.h"
+#include "nativeui/gfx/display_list.h"
+#include "nativeui/gfx/screen.h"
+#include "nativeui/group.h"
+#include "nativeui/state.h"
+#include "nativeui/util/layout_snapshot.h"
+#include "nativeui/util/tile_cache.h"
+#include "nativeui/util/yoga_util.h"
+#include "nativeui/window.h"
 #include "third_party/yoga/yoga/Yoga.h"
 
 namespace nu {
@@ -25,16 +36,45 @@ inline RectF GetYGNodeBounds(YGNodeRef node) {
                YGNodeLayoutGetWidth(node), YGNodeLayoutGetHeight(node));
 }
 
+// How many preferred size queries are remembered.
+const size_t kMaxPreferredSizes = 4;
+
+// Compare constraints, which may be NaN.
+inline bool IsSameConstraint(float a, float b) {
+  return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+// Collect views of the yoga tree in pre-order.
+void CollectLayoutViews(View* view, std::vector<View*>* views) {
+  views->push_back(view);
+  // Only containers add children to yoga nodes.
+  if (YGNodeGetChildCount(view->node()) == 0)
+    return;
+  Container* container = static_cast<Container*>(view);
+  for (int i = 0; i < container->ChildCount(); ++i)
+    CollectLayoutViews(container->ChildAt(i), views);
+}
+
+// Find the window the view belongs to, View::GetWindow() is only reliable for
+// direct children of the content view.
+inline Window* GetLayoutWindow(View* view) {
+  while (view->GetParent())
+    view = view->GetParent();
+  return view->GetWindow();
+}
+
 }  // namespace
 
 // static
 const char Container::kClassName[] = "Container";
 
-Container::Container() {
+Container::Container()
+    : tile_memory_limit_(TileCache::kDefaultMemoryLimit) {
   PlatformInit();
 }
 
-Container::Container(const char* an_empty_constructor) {
+Container::Container(const char* an_empty_constructor)
+    : tile_memory_limit_(TileCache::kDefaultMemoryLimit) {
 }
 
 Container::~Container() {
@@ -46,50 +86,202 @@ const char* Container::GetClassName() const {
 }
 
 void Container::Layout() {
+  // Layout is requested when children or styles change.
+  preferred_sizes_.clear();
+
+  // The running async layout has copied the old styles, which must not be
+  // applied even if the layout is deferred by BeginUpdate.
+  Window* window = GetLayoutWindow(this);
+  if (window)
+    window->InvalidateAsyncLayout();
+
+  // Defer the layout until EndUpdate is called.
+  if (update_depth_ > 0) {
+    needs_layout_ = true;
+    return;
+  }
+
+  // Let the window compute the layout once before next redraw.
+  if (window && window->ShouldDeferLayout()) {
+    // The parents are not notified until the deferred layout happens.
+    InvalidatePreferredSize();
+    if (!dirty_) {
+      dirty_ = true;
+      window->ScheduleLayout(this);
+    }
+    return;
+  }
+
+  DoLayout();
+}
+
+void Container::DoLayout() {
   // For child CSS node, tell parent to do the layout.
   if (!IsRootYGNode(this)) {
     dirty_ = true;
     static_cast<Container*>(GetParent())->Layout();
-    // The parent may choose to not update this view because its size is not
-    // changed, in that case we need to force updating here.
-    // This usually happens after adding a child view, since the container does
-    // not change its size.
-    // TODO(zcbenz): Revisit the logic here, should have a cleaner way.
+    // The parent usually reaches this container through the new layout of
+    // yoga nodes, but if yoga reused cached results nothing would update
+    // the children.
     if (dirty_)
       SetChildBoundsFromCSS();
     return;
   }
 
   // So this is a root CSS node, calculate the layout and set bounds.
+  Window* window = GetLayoutWindow(this);
+  if (window)
+    window->InvalidateAsyncLayout();
+  LayoutStats* stats = State::GetCurrent()->layout_stats();
+  LayoutStats before(*stats);
+  LayoutStats window_before(window ? *window->layout_stats() : LayoutStats());
   SizeF size(GetBounds().size());
-  YGNodeCalculateLayout(node(), size.width(), size.height(), YGDirectionLTR);
+  base::TimeTicks start = base::TimeTicks::Now();
+  CalculateYogaLayout(node(), size.width(), size.height());
+  stats->layout_time += base::TimeTicks::Now() - start;
+  stats->layout_passes++;
+  stats->nodes_visited++;
   SetChildBoundsFromCSS();
+
+  // Also count the work for the window. Nested yoga roots laid out when
+  // setting bounds have added their work, which is already included.
+  if (window) {
+    *window->layout_stats() = window_before;
+    *window->layout_stats() += *stats - before;
+  }
 }
 
 void Container::OnSizeChanged() {
   View::OnSizeChanged();
-  if (IsRootYGNode(this))
-    Layout();
-  else
+  display_list_.reset();
+  if (tile_cache_)
+    tile_cache_->Clear();
+  if (IsRootYGNode(this)) {
+    // Resizing must not wait for the deferred layout, otherwise children would
+    // be drawn in old positions.
+    DoLayout();
+  } else if (GetBounds().size() != children_bounds_size_) {
+    // On some platforms the children have already been updated when the
+    // native view received the new size.
     SetChildBoundsFromCSS();
+  }
+}
+
+void Container::SchedulePaint() {
+  display_list_.reset();
+  if (tile_cache_)
+    tile_cache_->Clear();
+  ++paint_requests_;
+  View::SchedulePaint();
+}
+
+void Container::SchedulePaintRect(const RectF& rect) {
+  // The recording covers the whole view, so it has to be recorded again.
+  display_list_.reset();
+  if (tile_cache_)
+    tile_cache_->Invalidate(rect);
+  ++paint_requests_;
+  View::SchedulePaintRect(rect);
+}
+
+void Container::SetCachedDrawing(bool cached) {
+  cached_drawing_ = cached;
+  display_list_.reset();
+}
+
+void Container::SetTiledDrawing(bool tiled) {
+  if (tiled == IsTiledDrawing())
+    return;
+  if (tiled)
+    tile_cache_.reset(new TileCache(tile_memory_limit_));
+  else
+    tile_cache_.reset();
+}
+
+void Container::SetTileMemoryLimit(size_t bytes) {
+  tile_memory_limit_ = bytes;
+  if (tile_cache_)
+    tile_cache_->SetMemoryLimit(bytes);
+}
+
+void Container::Draw(Painter* painter, const RectF& dirty) {
+  if (tile_cache_) {
+    DrawTiles(painter, dirty);
+    return;
+  }
+  if (!cached_drawing_) {
+    on_draw.Emit(this, painter, dirty);
+    return;
+  }
+  if (display_list_) {
+    display_list_->Replay(painter);
+    return;
+  }
+
+  // Record the whole view so the list can be replayed for any dirty rect.
+  std::unique_ptr<DisplayList> list(new DisplayList);
+  list->set_measure_painter(painter);
+  int paint_requests = paint_requests_;
+  on_draw.Emit(this, list.get(), RectF(GetBounds().size()));
+  list->set_measure_painter(nullptr);
+  list->Replay(painter);
+
+  // Handlers that schedule another paint while drawing are animating.
+  if (paint_requests == paint_requests_)
+    display_list_ = std::move(list);
+}
+
+void Container::DrawTiles(Painter* painter, const RectF& dirty) {
+  RectF bounds(GetBounds().size());
+  RectF area(dirty);
+  area.Intersect(bounds);
+  if (area.IsEmpty())
+    return;
+
+  // Tiles are painted for the screen the window is on.
+  Window* window = GetWindow();
+  float scale_factor = window ? window->GetScaleFactor() : GetScaleFactor();
+  const float size = TileCache::kTileSize;
+  int first_column = static_cast<int>(std::floor(area.x() / size));
+  int last_column = static_cast<int>(std::ceil(area.right() / size));
+  int first_row = static_cast<int>(std::floor(area.y() / size));
+  int last_row = static_cast<int>(std::ceil(area.bottom() / size));
+  for (int row = first_row; row < last_row; ++row) {
+    for (int column = first_column; column < last_column; ++column) {
+      RectF rect = TileCache::GetTileRect(column, row);
+      scoped_refptr<Canvas> tile = tile_cache_->Get(column, row);
+      if (!tile || tile->GetScaleFactor() != scale_factor) {
+        // Only the part inside the view is painted.
+        RectF tile_dirty(rect);
+        tile_dirty.Intersect(bounds);
+        tile = new Canvas(rect.size(), scale_factor);
+        Painter* tile_painter = tile->GetPainter();
+        tile_painter->Translate(Vector2dF(-rect.x(), -rect.y()));
+        tile_painter->ClipRect(tile_dirty);
+        int paint_requests = paint_requests_;
+        on_draw.Emit(this, tile_painter, tile_dirty);
+        // Tiles of animating handlers are outdated once painted.
+        if (paint_requests == paint_requests_)
+          tile_cache_->Put(column, row, tile.get());
+      }
+      painter->DrawCanvas(tile.get(), rect);
+    }
+  }
 }
 
 SizeF Container::GetPreferredSize() const {
   float nan = std::numeric_limits<float>::quiet_NaN();
-  YGNodeCalculateLayout(node(), nan, nan, YGDirectionLTR);
-  return SizeF(YGNodeLayoutGetWidth(node()), YGNodeLayoutGetHeight(node()));
+  return GetPreferredSizeFor(nan, nan);
 }
 
 float Container::GetPreferredHeightForWidth(float width) const {
   float nan = std::numeric_limits<float>::quiet_NaN();
-  YGNodeCalculateLayout(node(), width, nan, YGDirectionLTR);
-  return YGNodeLayoutGetHeight(node());
+  return GetPreferredSizeFor(width, nan).height();
 }
 
 float Container::GetPreferredWidthForHeight(float height) const {
   float nan = std::numeric_limits<float>::quiet_NaN();
-  YGNodeCalculateLayout(node(), nan, height, YGDirectionLTR);
-  return YGNodeLayoutGetWidth(node());
+  return GetPreferredSizeFor(nan, height).width();
 }
 
 void Container::AddChildView(View* view) {
@@ -121,6 +313,9 @@ void Container::AddChildViewAt(View* view, int index) {
 }
 
 void Container::RemoveChildView(View* view) {
+  // Quick check without walking through children.
+  if (!view || view->GetParent() != this)
+    return;
   const auto i(std::find(children_.begin(), children_.end(), view));
   if (i == children_.end())
     return;
@@ -136,12 +331,206 @@ void Container::RemoveChildView(View* view) {
   Layout();
 }
 
+void Container::AddChildViews(const std::vector<View*>& views) {
+  std::vector<View*> added;
+  added.reserve(views.size());
+  children_.reserve(children_.size() + views.size());
+  for (View* view : views) {
+    if (!view || view == this)
+      continue;
+    if (view->GetParent()) {
+      LOG(ERROR) << "The view already has a parent.";
+      continue;
+    }
+    YGNodeInsertChild(node(), view->node(), ChildCount());
+    view->SetParent(this);
+    children_.push_back(view);
+    added.push_back(view);
+  }
+  if (added.empty())
+    return;
+
+  PlatformAddChildViews(added);
+
+  DCHECK_EQ(static_cast<int>(YGNodeGetChildCount(node())), ChildCount());
+
+  Layout();
+}
+
+void Container::RemoveAllChildViews() {
+  if (children_.empty())
+    return;
+
+  // Detach the yoga children at once, yoga would search its child list when
+  // removing each of them.
+  ReplaceYogaNode(yoga_config(), false);
+  PlatformRemoveAllChildViews();
+  for (const auto& view : children_)
+    view->SetParent(nullptr);
+  children_.clear();
+
+  DCHECK_EQ(static_cast<int>(YGNodeGetChildCount(node())), 0);
+
+  Layout();
+}
+
+void Container::ReplaceChildViews(const std::vector<View*>& views) {
+  // Keep the new views alive in case some of them are current children.
+  std::vector<scoped_refptr<View>> refs(views.begin(), views.end());
+  BeginUpdate();
+  RemoveAllChildViews();
+  AddChildViews(views);
+  EndUpdate();
+}
+
+void Container::MoveChildView(View* view, int index) {
+  if (!view || view->GetParent() != this || index < 0 || index >= ChildCount())
+    return;
+  const auto i(std::find(children_.begin(), children_.end(), view));
+  if (i == children_.end())
+    return;
+  int old_index = static_cast<int>(i - children_.begin());
+  if (old_index == index)
+    return;
+
+  YGNodeRemoveChild(node(), view->node());
+  YGNodeInsertChild(node(), view->node(), index);
+
+  // Shift the elements between old and new positions.
+  if (old_index < index)
+    std::rotate(i, i + 1, children_.begin() + index + 1);
+  else
+    std::rotate(children_.begin() + index, i, i + 1);
+
+  // Keep the stacking order of native views same with children.
+  PlatformMoveChildView(view, index);
+  SchedulePaint();
+
+  Layout();
+}
+
+void Container::BeginUpdate() {
+  ++update_depth_;
+}
+
+void Container::EndUpdate() {
+  DCHECK_GT(update_depth_, 0) << "EndUpdate called without BeginUpdate";
+  if (update_depth_ == 0 || --update_depth_ > 0 || !needs_layout_)
+    return;
+  needs_layout_ = false;
+  Layout();
+}
+
+SizeF Container::GetPreferredSizeFor(float width, float height) const {
+  // Styles of the subtree have been changed without requesting layout.
+  if (YGNodeIsDirty(node()))
+    preferred_sizes_.clear();
+
+  for (const PreferredSize& cached : preferred_sizes_) {
+    if (IsSameConstraint(cached.width, width) &&
+        IsSameConstraint(cached.height, height))
+      return cached.size;
+  }
+
+  // Compute on a copy of the tree, so the layout results of the real nodes
+  // are kept.
+  YGNodeRef clone = CloneYogaTree(node(), yoga_config());
+  CalculateYogaLayout(clone, width, height);
+  SizeF size(YGNodeLayoutGetWidth(clone), YGNodeLayoutGetHeight(clone));
+  FreeYogaTree(clone);
+
+  if (preferred_sizes_.size() >= kMaxPreferredSizes)
+    preferred_sizes_.erase(preferred_sizes_.begin());
+  preferred_sizes_.push_back({width, height, size});
+  return size;
+}
+
+void Container::InvalidatePreferredSize() {
+  Container* container = this;
+  while (container) {
+    container->preferred_sizes_.clear();
+    // The content view of Group is not part of the parent's yoga tree.
+    View* parent = container->GetParent();
+    if (!parent || parent->GetClassName() == Group::kClassName)
+      break;
+    container = static_cast<Container*>(parent);
+  }
+}
+
+scoped_refptr<LayoutSnapshot> Container::CreateLayoutSnapshot() {
+  return new LayoutSnapshot(node(), yoga_config(), GetBounds().size());
+}
+
+bool Container::AdoptLayoutSnapshot(LayoutSnapshot* snapshot) {
+  const std::vector<YGNodeRef>& originals = snapshot->originals();
+  std::vector<View*> views;
+  views.reserve(originals.size());
+  CollectLayoutViews(this, &views);
+  if (views.size() != originals.size())
+    return false;
+  for (size_t i = 0; i < views.size(); ++i) {
+    if (views[i]->node() != originals[i])
+      return false;
+  }
+
+  // Give the computed nodes to views, and free the old tree.
+  const std::vector<YGNodeRef>& nodes = snapshot->nodes();
+  for (size_t i = 0; i < views.size(); ++i) {
+    YGNodeSetContext(nodes[i], views[i]);
+    YGNodeSetMeasureFunc(nodes[i], YGNodeGetMeasureFunc(originals[i]));
+    views[i]->node_ = nodes[i];
+  }
+  FreeYogaTree(originals[0]);
+  snapshot->ReleaseTree();
+
+  // Views that were measured with unknown widths must be measured again.
+  bool missed = false;
+  for (const LayoutSnapshot::Measurement& m : snapshot->measurements()) {
+    if (m.missed) {
+      YGNodeMarkDirty(nodes[m.index]);
+      missed = true;
+    }
+  }
+  if (missed)
+    DoLayout();
+  else
+    SetChildBoundsFromCSS();
+  return true;
+}
+
 void Container::SetChildBoundsFromCSS() {
+  LayoutStats* stats = State::GetCurrent()->layout_stats();
   dirty_ = false;
+  children_bounds_size_ = GetBounds().size();
+  ++child_bounds_updates_;
   for (int i = 0; i < ChildCount(); ++i) {
     View* child = ChildAt(i);
-    if (child->IsVisible())
-      child->SetBounds(GetYGNodeBounds(child->node()));
+    if (!child->IsVisible())
+      continue;
+    YGNodeRef node = child->node();
+    bool has_new_layout = YGNodeGetHasNewLayout(node);
+    YGNodeSetHasNewLayout(node, false);
+    if (has_new_layout)
+      stats->nodes_visited++;
+    // Only containers add children to yoga nodes.
+    Container* container = YGNodeGetChildCount(node) > 0 ?
+        static_cast<Container*>(child) : nullptr;
+    int updates = container ? container->child_bounds_updates_ : 0;
+    // The native bounds are compared instead of the ones set last time, since
+    // on some platforms they are relative to the window and change when this
+    // container moves. They are compared after pixel snapping, otherwise
+    // fractional layouts would always look changed.
+    RectF bounds = GetYGNodeBounds(node);
+    if (child->IsBoundsChangedBy(bounds)) {
+      child->SetBounds(bounds);
+      stats->bounds_changes++;
+    }
+    // Yoga only computes the subtree when the node has new layout, in which
+    // case the grandchildren may have moved even though the child did not
+    // change its size. Skip it if resizing the child has updated them.
+    if (has_new_layout && container &&
+        container->child_bounds_updates_ == updates)
+      container->SetChildBoundsFromCSS();
   }
 }
 
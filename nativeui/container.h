@@ -5,13 +5,17 @@
 #ifndef NATIVEUI_CONTAINER_H_
 #define NATIVEUI_CONTAINER_H_
 
+#include <memory>
 #include <vector>
 
 #include "nativeui/view.h"
 
 namespace nu {
 
+class DisplayList;
+class LayoutSnapshot;
 class Painter;
+class TileCache;
 
 class NATIVEUI_EXPORT Container : public View {
  public:
@@ -24,8 +28,11 @@ class NATIVEUI_EXPORT Container : public View {
   const char* GetClassName() const override;
   void Layout() override;
   void OnSizeChanged() override;
+  void SchedulePaint() override;
+  void SchedulePaintRect(const RectF& rect) override;
 
-  // Gets preferred size of view.
+  // Gets preferred size of view. The queries do not change current layout,
+  // and results are cached until children or styles change.
   SizeF GetPreferredSize() const;
 
   // Returns the preferred width/height for the specified height/width.
@@ -37,6 +44,18 @@ class NATIVEUI_EXPORT Container : public View {
   void AddChildViewAt(View* view, int index);
   void RemoveChildView(View* view);
 
+  // Bulk operations on children, each one only runs layout once.
+  void AddChildViews(const std::vector<View*>& views);
+  void RemoveAllChildViews();
+  void ReplaceChildViews(const std::vector<View*>& views);
+  void MoveChildView(View* view, int index);
+
+  // Defer layout until the outermost EndUpdate is called, so adding or
+  // removing lots of children only computes the layout once.
+  void BeginUpdate();
+  void EndUpdate();
+  bool IsUpdating() const { return update_depth_ > 0; }
+
   // Get children.
   int ChildCount() const { return static_cast<int>(children_.size()); }
   View* ChildAt(int index) const {
@@ -45,9 +64,42 @@ class NATIVEUI_EXPORT Container : public View {
     return children_[index].get();
   }
 
-  // Internal: Used by certain implementations to refresh layout.
+  // Internal: Used by certain implementations to refresh layout. Children
+  // whose native bounds are already the computed ones are skipped.
   void SetChildBoundsFromCSS();
 
+  // Internal: Whether children's bounds are waiting for a layout.
+  bool IsLayoutDirty() const { return dirty_; }
+
+  // Internal: Copy the yoga tree for computing layout on other thread.
+  scoped_refptr<LayoutSnapshot> CreateLayoutSnapshot();
+
+  // Internal: Replace the yoga nodes of this container and its descendants
+  // with the computed ones in |snapshot|, and update children. Return false
+  // if the tree has been changed since the snapshot was taken.
+  bool AdoptLayoutSnapshot(LayoutSnapshot* snapshot);
+
+  // When enabled, the painting of on_draw handlers is recorded and replayed
+  // for later redraws, until SchedulePaint is called or the view is resized.
+  // The handlers always receive the whole view as the dirty rect.
+  void SetCachedDrawing(bool cached);
+  bool IsCachedDrawing() const { return cached_drawing_; }
+
+  // When enabled, the painting of on_draw handlers is rendered into tiles of
+  // fixed size that are kept until invalidated, so redrawing a large container
+  // like scrolling it only copies the tiles. The handlers are called for each
+  // missing tile with the tile as the dirty rect. SchedulePaintRect only
+  // invalidates the tiles in the rect, and resizing invalidates all tiles.
+  void SetTiledDrawing(bool tiled);
+  bool IsTiledDrawing() const { return !!tile_cache_; }
+
+  // Set the maximum bytes of memory used by tiles, the least recently drawn
+  // tiles are dropped when exceeded.
+  void SetTileMemoryLimit(size_t bytes);
+
+  // Internal: Emit on_draw, or replay the recorded painting.
+  void Draw(Painter* painter, const RectF& dirty);
+
   // Events.
   Signal<void(Container*, Painter*, const RectF&)> on_draw;
 
@@ -61,13 +113,78 @@ class NATIVEUI_EXPORT Container : public View {
   void PlatformDestroy();
   void PlatformAddChildView(View* view);
   void PlatformRemoveChildView(View* view);
+  // Add |views|, which have been appended to children, at once.
+  void PlatformAddChildViews(const std::vector<View*>& views);
+  // Remove the native views of all children, before children is cleared.
+  void PlatformRemoveAllChildViews();
+  // Restack the native |view|, which has been moved to |index| in children.
+  void PlatformMoveChildView(View* view, int index);
 
  private:
+  // Calculate the layout and update children's bounds immediately.
+  void DoLayout();
+
+  // Draw the tiles in |dirty|, rendering the missing ones.
+  void DrawTiles(Painter* painter, const RectF& dirty);
+
+  // Compute the size for the constraints, NaN means no constraint.
+  SizeF GetPreferredSizeFor(float width, float height) const;
+
+  // Clear cached preferred sizes of this container and its ancestors.
+  void InvalidatePreferredSize();
+
   // Relationships.
   std::vector<scoped_refptr<View>> children_;
 
   // Whether the container should update children's layout.
   bool dirty_ = false;
+
+  // Results of recent preferred size queries.
+  struct PreferredSize {
+    float width;
+    float height;
+    SizeF size;
+  };
+  mutable std::vector<PreferredSize> preferred_sizes_;
+
+  // Recorded painting of on_draw handlers.
+  bool cached_drawing_ = false;
+  std::unique_ptr<DisplayList> display_list_;
+  int paint_requests_ = 0;
+
+  // Rendered tiles of on_draw handlers.
+  std::unique_ptr<TileCache> tile_cache_;
+  size_t tile_memory_limit_;
+
+  // The size of container when children's bounds were last set.
+  SizeF children_bounds_size_;
+
+  // How many times children's bounds have been set.
+  int child_bounds_updates_ = 0;
+
+  // Nesting level of BeginUpdate calls.
+  int update_depth_ = 0;
+
+  // Whether a layout was requested during the update.
+  bool needs_layout_ = false;
+};
+
+// Helper to batch updates of a container in current scope.
+class ScopedContainerUpdate {
+ public:
+  explicit ScopedContainerUpdate(Container* container)
+      : container_(container) {
+    container_->BeginUpdate();
+  }
+
+  ~ScopedContainerUpdate() {
+    container_->EndUpdate();
+  }
+
+ private:
+  scoped_refptr<Container> container_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedContainerUpdate);
 };
 
 }  // namespace nu
@@ -0,0 +1,88 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <vector>
+
+#include "nativeui/nativeui.h"
+#include "nativeui/test/perf_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+const int kChildCount = 10000;
+
+}  // namespace
+
+class ContainerPerfTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    window_ = new nu::Window(nu::Window::Options());
+    window_->SetContentSize(nu::SizeF(400, 400));
+    container_ = new nu::Container;
+    window_->SetContentView(container_.get());
+  }
+
+  std::vector<nu::View*> CreateChildren(int count) {
+    std::vector<nu::View*> children;
+    children.reserve(count);
+    for (int i = 0; i < count; ++i) {
+      nu::Container* child = new nu::Container;
+      child->SetStyleProperty("height", 10);
+      children.push_back(child);
+    }
+    return children;
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::Window> window_;
+  scoped_refptr<nu::Container> container_;
+};
+
+TEST_F(ContainerPerfTest, AddChildViewOneByOne) {
+  // Every insertion does a full layout, so use fewer children.
+  const int count = kChildCount / 10;
+  std::vector<nu::View*> children = CreateChildren(count);
+  nu::PerfTimer timer;
+  for (nu::View* child : children)
+    container_->AddChildView(child);
+  timer.PrintPerOp("container_add_child", "one_by_one", count);
+  EXPECT_EQ(container_->ChildCount(), count);
+}
+
+TEST_F(ContainerPerfTest, AddChildViews) {
+  std::vector<nu::View*> children = CreateChildren(kChildCount);
+  nu::PerfTimer timer;
+  container_->AddChildViews(children);
+  timer.PrintPerOp("container_add_child", "add_child_views", kChildCount);
+  EXPECT_EQ(container_->ChildCount(), kChildCount);
+}
+
+TEST_F(ContainerPerfTest, BeginEndUpdate) {
+  std::vector<nu::View*> children = CreateChildren(kChildCount);
+  nu::PerfTimer timer;
+  container_->BeginUpdate();
+  for (nu::View* child : children)
+    container_->AddChildView(child);
+  container_->EndUpdate();
+  timer.PrintPerOp("container_add_child", "begin_end_update", kChildCount);
+  EXPECT_EQ(container_->ChildCount(), kChildCount);
+}
+
+TEST_F(ContainerPerfTest, RemoveAllChildViews) {
+  container_->AddChildViews(CreateChildren(kChildCount));
+  nu::PerfTimer timer;
+  container_->RemoveAllChildViews();
+  timer.PrintPerOp("container_remove_child", "remove_all", kChildCount);
+  EXPECT_EQ(container_->ChildCount(), 0);
+}
+
+TEST_F(ContainerPerfTest, ReplaceChildViews) {
+  container_->AddChildViews(CreateChildren(kChildCount));
+  std::vector<nu::View*> children = CreateChildren(kChildCount);
+  nu::PerfTimer timer;
+  container_->ReplaceChildViews(children);
+  timer.PrintPerOp("container_replace_child", "replace_all", kChildCount);
+  EXPECT_EQ(container_->ChildCount(), kChildCount);
+}
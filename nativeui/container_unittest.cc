@@ -79,6 +79,12 @@ TEST_F(ContainerTest, Layout) {
   EXPECT_EQ(container_->layout_count(), 3);
 }
 
+TEST_F(ContainerTest, SetStyleLayoutOnce) {
+  int count = container_->layout_count();
+  container_->SetStyle("flex-direction", "row", "padding", 5, "flex", 1);
+  EXPECT_EQ(container_->layout_count(), count + 1);
+}
+
 TEST_F(ContainerTest, ChildLayout) {
   window_->SetBounds(nu::RectF(0, 0, 100, 200));
   TestContainer* c1 = new TestContainer;
@@ -138,3 +144,287 @@ TEST_F(ContainerTest, MoveBetweenContainers) {
   EXPECT_EQ(v1->GetBounds(), nu::RectF(0, 0, 200, 100));
   EXPECT_EQ(v2->GetBounds(), nu::RectF(0, 100, 200, 100));
 }
+
+TEST_F(ContainerTest, AddChildViews) {
+  nu::Label* v1 = new nu::Label;
+  nu::Label* v2 = new nu::Label;
+  container_->AddChildViews({v1, v2});
+  EXPECT_EQ(container_->ChildCount(), 2);
+  EXPECT_EQ(container_->ChildAt(0), v1);
+  EXPECT_EQ(container_->ChildAt(1), v2);
+}
+
+TEST_F(ContainerTest, AddChildViewsSkipsInvalidViews) {
+  nu::Label* v1 = new nu::Label;
+  container_->AddChildViews({v1, nullptr, v1, container_.get()});
+  EXPECT_EQ(container_->ChildCount(), 1);
+  EXPECT_EQ(container_->ChildAt(0), v1);
+}
+
+TEST_F(ContainerTest, RemoveAllChildViews) {
+  scoped_refptr<nu::Label> v1 = new nu::Label;
+  container_->AddChildViews({v1.get(), new nu::Label});
+  container_->RemoveAllChildViews();
+  EXPECT_EQ(container_->ChildCount(), 0);
+  EXPECT_EQ(v1->GetParent(), nullptr);
+  container_->AddChildView(v1.get());
+  EXPECT_EQ(container_->ChildCount(), 1);
+}
+
+TEST_F(ContainerTest, RemoveAllChildViewsKeepsLayout) {
+  window_->SetContentSize(nu::SizeF(200, 400));
+  scoped_refptr<nu::Container> c = new nu::Container;
+  c->SetStyle("flex", 1);
+  container_->AddChildView(c.get());
+  c->AddChildViews({new nu::Container, new nu::Container});
+  c->RemoveAllChildViews();
+  scoped_refptr<nu::Container> v1 = new nu::Container;
+  v1->SetStyle("flex", 1);
+  c->AddChildView(v1.get());
+  EXPECT_EQ(c->GetBounds(), nu::RectF(0, 0, 200, 400));
+  EXPECT_EQ(v1->GetBounds(), nu::RectF(0, 0, 200, 400));
+}
+
+TEST_F(ContainerTest, ReplaceChildViews) {
+  scoped_refptr<nu::Label> v1 = new nu::Label;
+  nu::Label* v2 = new nu::Label;
+  nu::Label* v3 = new nu::Label;
+  container_->AddChildViews({v1.get(), v2});
+  container_->ReplaceChildViews({v3, v1.get()});
+  EXPECT_EQ(container_->ChildCount(), 2);
+  EXPECT_EQ(container_->ChildAt(0), v3);
+  EXPECT_EQ(container_->ChildAt(1), v1.get());
+}
+
+TEST_F(ContainerTest, MoveChildView) {
+  nu::Label* v1 = new nu::Label;
+  nu::Label* v2 = new nu::Label;
+  nu::Label* v3 = new nu::Label;
+  container_->AddChildViews({v1, v2, v3});
+  container_->MoveChildView(v1, 2);
+  EXPECT_EQ(container_->ChildAt(0), v2);
+  EXPECT_EQ(container_->ChildAt(1), v3);
+  EXPECT_EQ(container_->ChildAt(2), v1);
+  container_->MoveChildView(v1, 0);
+  EXPECT_EQ(container_->ChildAt(0), v1);
+  EXPECT_EQ(container_->ChildAt(1), v2);
+  EXPECT_EQ(container_->ChildAt(2), v3);
+}
+
+TEST_F(ContainerTest, BatchUpdate) {
+  window_->SetContentSize(nu::SizeF(200, 400));
+  scoped_refptr<nu::Container> v1 = new nu::Container;
+  v1->SetStyle("flex", 1);
+  scoped_refptr<nu::Container> v2 = new nu::Container;
+  v2->SetStyle("flex", 1);
+  {
+    nu::ScopedContainerUpdate update(container_.get());
+    container_->AddChildView(v1.get());
+    container_->AddChildView(v2.get());
+    EXPECT_TRUE(container_->IsUpdating());
+    EXPECT_EQ(v2->GetBounds(), nu::RectF());
+  }
+  EXPECT_FALSE(container_->IsUpdating());
+  EXPECT_EQ(v1->GetBounds(), nu::RectF(0, 0, 200, 200));
+  EXPECT_EQ(v2->GetBounds(), nu::RectF(0, 200, 200, 200));
+}
+
+TEST_F(ContainerTest, DeferredLayout) {
+  window_->SetContentSize(nu::SizeF(200, 400));
+  window_->SetDeferredLayout(true);
+  scoped_refptr<nu::Container> v1 = new nu::Container;
+  v1->SetStyle("flex", 1);
+  scoped_refptr<nu::Container> v2 = new nu::Container;
+  v2->SetStyle("flex", 1);
+  container_->AddChildView(v1.get());
+  container_->AddChildView(v2.get());
+  EXPECT_TRUE(container_->IsLayoutDirty());
+  EXPECT_EQ(v2->GetBounds(), nu::RectF());
+  window_->FlushLayout();
+  EXPECT_FALSE(container_->IsLayoutDirty());
+  EXPECT_EQ(v1->GetBounds(), nu::RectF(0, 0, 200, 200));
+  EXPECT_EQ(v2->GetBounds(), nu::RectF(0, 200, 200, 200));
+  container_->RemoveChildView(v1.get());
+  window_->SetDeferredLayout(false);
+  EXPECT_EQ(v2->GetBounds(), nu::RectF(0, 0, 200, 400));
+}
+
+TEST_F(ContainerTest, DeferredLayoutInScroll) {
+  window_->SetContentSize(nu::SizeF(200, 400));
+  scoped_refptr<nu::Scroll> scroll = new nu::Scroll;
+  scroll->SetStyle("flex", 1);
+  container_->AddChildView(scroll.get());
+  scroll->SetContentSize(nu::SizeF(200, 400));
+  window_->SetDeferredLayout(true);
+  // The content view of Scroll is the root of its own yoga tree.
+  nu::Container* content = static_cast<nu::Container*>(
+      scroll->GetContentView());
+  scoped_refptr<nu::Container> v1 = new nu::Container;
+  v1->SetStyle("flex", 1);
+  content->AddChildView(v1.get());
+  EXPECT_TRUE(content->IsLayoutDirty());
+  window_->FlushLayout();
+  EXPECT_FALSE(content->IsLayoutDirty());
+  EXPECT_EQ(v1->GetBounds(), nu::RectF(content->GetBounds().size()));
+}
+
+#if !defined(OS_WIN)
+TEST_F(ContainerTest, AsyncLayout) {
+  window_->SetContentSize(nu::SizeF(200, 400));
+  window_->SetAsyncLayout(true);
+  window_->ResetLayoutStats();
+  scoped_refptr<nu::Container> v1 = new nu::Container;
+  v1->SetStyle("flex", 1);
+  scoped_refptr<nu::Container> v2 = new nu::Container;
+  v2->SetStyle("flex", 1);
+  container_->AddChildViews({v1.get(), v2.get()});
+  EXPECT_TRUE(container_->IsLayoutDirty());
+  // The last child is sized when the computed layout is applied.
+  v2->on_size_changed.Connect([this](nu::View*) { lifetime_.Quit(); });
+  lifetime_.Run();
+  EXPECT_FALSE(container_->IsLayoutDirty());
+  EXPECT_EQ(v1->GetBounds(), nu::RectF(0, 0, 200, 200));
+  EXPECT_EQ(v2->GetBounds(), nu::RectF(0, 200, 200, 200));
+  EXPECT_EQ(window_->GetLayoutStats().layout_passes, 1);
+}
+
+TEST_F(ContainerTest, AsyncLayoutStyleChangedInUpdate) {
+  window_->SetContentSize(nu::SizeF(200, 400));
+  window_->SetAsyncLayout(true);
+  scoped_refptr<nu::Label> v1 = new nu::Label("label");
+  v1->SetStyle("height", 100);
+  scoped_refptr<nu::Container> v2 = new nu::Container;
+  v2->SetStyle("flex", 1);
+  container_->AddChildViews({v1.get(), v2.get()});
+  // Runs after the snapshot is taken and before its result is applied.
+  lifetime_.PostIdleTask([this, v1]() {
+    nu::ScopedContainerUpdate update(container_.get());
+    v1->SetStyle("height", 300);
+  });
+  v2->on_size_changed.Connect([this](nu::View*) { lifetime_.Quit(); });
+  lifetime_.Run();
+  EXPECT_EQ(v1->GetBounds(), nu::RectF(0, 0, 200, 300));
+  EXPECT_EQ(v2->GetBounds(), nu::RectF(0, 300, 200, 100));
+}
+#endif
+
+TEST_F(ContainerTest, NestedLayoutKeepsSize) {
+  window_->SetContentSize(nu::SizeF(200, 400));
+  nu::Container* c = new nu::Container;
+  c->SetStyle("width", 100, "height", 100);
+  container_->AddChildView(c);
+  scoped_refptr<nu::Container> v1 = new nu::Container;
+  v1->SetStyle("flex", 1);
+  scoped_refptr<nu::Container> v2 = new nu::Container;
+  v2->SetStyle("flex", 1);
+  c->AddChildView(v1.get());
+  EXPECT_EQ(v1->GetBounds(), nu::RectF(0, 0, 100, 100));
+  c->AddChildView(v2.get());
+  EXPECT_EQ(v1->GetBounds(), nu::RectF(0, 0, 100, 50));
+  EXPECT_EQ(v2->GetBounds(), nu::RectF(0, 50, 100, 50));
+  window_->SetContentSize(nu::SizeF(300, 300));
+  EXPECT_EQ(c->GetBounds(), nu::RectF(0, 0, 100, 100));
+  EXPECT_EQ(v2->GetBounds(), nu::RectF(0, 50, 100, 50));
+}
+
+TEST_F(ContainerTest, PreferredSizeKeepsLayout) {
+  window_->SetContentSize(nu::SizeF(200, 400));
+  scoped_refptr<nu::Container> v1 = new nu::Container;
+  v1->SetStyle("height", 50);
+  scoped_refptr<nu::Container> v2 = new nu::Container;
+  v2->SetStyle("flex", 1);
+  container_->AddChildViews({v1.get(), v2.get()});
+  EXPECT_EQ(container_->GetPreferredSize(), nu::SizeF(0, 50));
+  EXPECT_EQ(container_->GetPreferredHeightForWidth(100), 50);
+  container_->SetChildBoundsFromCSS();
+  EXPECT_EQ(v2->GetBounds(), nu::RectF(0, 50, 200, 350));
+  v2->SetStyle("flex", 0, "height", 100);
+  EXPECT_EQ(container_->GetPreferredSize(), nu::SizeF(0, 150));
+  EXPECT_EQ(v2->GetBounds(), nu::RectF(0, 50, 200, 100));
+}
+
+TEST_F(ContainerTest, LayoutStats) {
+  window_->SetContentSize(nu::SizeF(200, 400));
+  window_->ResetLayoutStats();
+  nu::App::GetCurrent()->ResetLayoutStats();
+  scoped_refptr<nu::Container> v1 = new nu::Container;
+  v1->SetStyle("flex", 1);
+  scoped_refptr<nu::Container> v2 = new nu::Container;
+  v2->SetStyle("flex", 1);
+  container_->AddChildView(v1.get());
+  container_->AddChildView(v2.get());
+  nu::LayoutStats stats = window_->GetLayoutStats();
+  EXPECT_EQ(stats.layout_passes, 2);
+  EXPECT_EQ(stats.bounds_changes, 3);
+  EXPECT_EQ(nu::App::GetCurrent()->GetLayoutStats().layout_passes, 2);
+  EXPECT_EQ(container_->DumpLayoutTree(),
+            "Container (0, 0, 200, 400)\n"
+            "  Container (0, 0, 200, 200)\n"
+            "  Container (0, 200, 200, 200)\n");
+}
+
+TEST_F(ContainerTest, LayoutStatsFractionalBounds) {
+  window_->SetContentSize(nu::SizeF(200, 400));
+  // The children get fractional heights.
+  for (int i = 0; i < 3; ++i) {
+    scoped_refptr<nu::Container> child = new nu::Container;
+    child->SetStyle("flex", 1);
+    container_->AddChildView(child.get());
+  }
+  window_->ResetLayoutStats();
+  container_->Layout();
+  EXPECT_EQ(window_->GetLayoutStats().bounds_changes, 0);
+}
+
+TEST_F(ContainerTest, LayoutStatsNestedRoot) {
+  window_->SetContentSize(nu::SizeF(200, 400));
+  scoped_refptr<nu::Scroll> scroll = new nu::Scroll;
+  scroll->SetStyle("flex", 1);
+  nu::Container* content = static_cast<nu::Container*>(
+      scroll->GetContentView());
+  scoped_refptr<nu::Container> v1 = new nu::Container;
+  v1->SetStyle("flex", 1);
+  content->AddChildView(v1.get());
+  window_->ResetLayoutStats();
+  nu::App::GetCurrent()->ResetLayoutStats();
+  container_->AddChildView(scroll.get());
+  scroll->SetContentSize(nu::SizeF(200, 400));
+  // Each pass is counted once even when a yoga root is laid out by another.
+  nu::LayoutStats stats = window_->GetLayoutStats();
+  nu::LayoutStats app_stats = nu::App::GetCurrent()->GetLayoutStats();
+  EXPECT_EQ(stats.layout_passes, app_stats.layout_passes);
+  EXPECT_EQ(stats.nodes_visited, app_stats.nodes_visited);
+  EXPECT_EQ(stats.bounds_changes, app_stats.bounds_changes);
+}
+
+TEST_F(ContainerTest, TiledDrawing) {
+  window_->SetContentSize(nu::SizeF(300, 600));
+  int draw_count = 0;
+  container_->on_draw.Connect([&](nu::Container*, nu::Painter*,
+                                  const nu::RectF& dirty) {
+    ++draw_count;
+  });
+  container_->SetTiledDrawing(true);
+  EXPECT_TRUE(container_->IsTiledDrawing());
+
+  // Each tile is only rendered once.
+  scoped_refptr<nu::Canvas> canvas(new nu::Canvas(nu::SizeF(300, 600)));
+  container_->Draw(canvas->GetPainter(), nu::RectF(0, 0, 300, 600));
+  EXPECT_EQ(draw_count, 6);
+  container_->Draw(canvas->GetPainter(), nu::RectF(0, 0, 300, 600));
+  EXPECT_EQ(draw_count, 6);
+
+  // Only the invalidated tiles are rendered again.
+  container_->SchedulePaintRect(nu::RectF(10, 10, 10, 10));
+  container_->Draw(canvas->GetPainter(), nu::RectF(0, 0, 300, 600));
+  EXPECT_EQ(draw_count, 7);
+  container_->SchedulePaint();
+  container_->Draw(canvas->GetPainter(), nu::RectF(0, 0, 100, 100));
+  EXPECT_EQ(draw_count, 8);
+
+  // Tiles are dropped when exceeding the memory limit.
+  container_->SetTileMemoryLimit(0);
+  container_->Draw(canvas->GetPainter(), nu::RectF(0, 0, 100, 100));
+  container_->Draw(canvas->GetPainter(), nu::RectF(0, 0, 100, 100));
+  EXPECT_EQ(draw_count, 10);
+}
@@ -13,4 +13,12 @@ const char* Entry::GetClassName() const {
   return kClassName;
 }
 
+SizeF Entry::Measure(float width) const {
+  // Entry scrolls its text, so it can be given any width.
+  SizeF size = GetMinimumSize();
+  if (width >= 0 && size.width() > width)
+    size.set_width(width);
+  return size;
+}
+
 }  // namespace nu
@@ -4,8 +4,18 @@
 
 #include "nativeui/gfx/canvas.h"
 
+#include "base/bind.h"
+#include "base/logging.h"
+#include "base/threading/thread.h"
+#include "nativeui/gfx/geometry/size_conversions.h"
 #include "nativeui/gfx/painter.h"
 #include "nativeui/gfx/screen.h"
+#include "nativeui/lifetime.h"
+#include "nativeui/state.h"
+
+#if defined(OS_WIN)
+#include "nativeui/gfx/win/gdiplus.h"
+#endif
 
 namespace nu {
 
@@ -20,8 +30,92 @@ Canvas::Canvas(const SizeF& size, float scale_factor)
       painter_(PlatformCreatePainter(bitmap_, scale_factor)) {
 }
 
+Canvas::Canvas(const PixelBuffer& pixels, float scale_factor)
+    : scale_factor_(scale_factor),
+      size_(pixels.width / scale_factor, pixels.height / scale_factor),
+      bitmap_(PlatformCreateBitmapFromPixels(pixels, scale_factor)),
+      painter_(PlatformCreatePainter(bitmap_, scale_factor)) {
+}
+
 Canvas::~Canvas() {
+  DCHECK(!painting_);
+  if (pixels_locked_)
+    UnlockPixels();
+  painter_.reset();
   PlatformDestroyBitmap(bitmap_);
+  if (release_pixels_)
+    release_pixels_();
+}
+
+// static
+Canvas* Canvas::CreateFromPixels(const PixelBuffer& pixels,
+                                 float scale_factor,
+                                 const std::function<void()>& release) {
+  DCHECK(pixels.data);
+  DCHECK_GE(pixels.stride, pixels.width * 4);
+  Canvas* canvas = new Canvas(pixels, scale_factor);
+  canvas->release_pixels_ = release;
+  return canvas;
+}
+
+Canvas::PixelBuffer Canvas::LockPixels() {
+  DCHECK(!pixels_locked_) << "Pixels can only be locked once";
+  DCHECK(!painting_) << "Pixels can not be locked while painting";
+  pixels_locked_ = true;
+  return PlatformLockPixels();
+}
+
+void Canvas::UnlockPixels(const Rect& dirty) {
+  DCHECK(pixels_locked_);
+  pixels_locked_ = false;
+  PlatformUnlockPixels(dirty);
+}
+
+void Canvas::UnlockPixels() {
+  UnlockPixels(Rect(ToFlooredSize(ScaleSize(size_, scale_factor_))));
+}
+
+void Canvas::PaintAsync(const PaintCallback& paint,
+                        const std::function<void()>& done) {
+  DCHECK(!painting_) << "Canvas is already being painted";
+  DCHECK(!pixels_locked_);
+  painting_ = true;
+  paint_done_ = done;
+  // Released in FinishPaintAsync, the refcount must only be changed on current
+  // thread.
+  AddRef();
+
+  Lifetime* lifetime = Lifetime::GetCurrent();
+  if (Lifetime::kThreadSafePostTask && lifetime) {
+    State::GetCurrent()->GetWorkerThread()->task_runner()->PostTask(
+        FROM_HERE, base::Bind(&Canvas::PaintOnWorker, base::Unretained(this),
+                              paint, lifetime));
+  } else if (lifetime) {
+    lifetime->PostTask([this, paint]() { PaintOnWorker(paint, nullptr); });
+  } else {
+    PaintOnWorker(paint, nullptr);
+  }
+}
+
+void Canvas::PaintOnWorker(const PaintCallback& paint, Lifetime* lifetime) {
+  // The painter of canvas is only used on the main thread.
+  std::unique_ptr<Painter> painter(PlatformCreatePainter(bitmap_,
+                                                         scale_factor_));
+  paint(painter.get());
+  painter.reset();
+  if (lifetime)
+    lifetime->PostTask([this]() { FinishPaintAsync(); });
+  else
+    FinishPaintAsync();
+}
+
+void Canvas::FinishPaintAsync() {
+  painting_ = false;
+  std::function<void()> done;
+  done.swap(paint_done_);
+  if (done)
+    done();
+  Release();
 }
 
 }  // namespace nu
@@ -5,19 +5,34 @@
 #ifndef NATIVEUI_GFX_CANVAS_H_
 #define NATIVEUI_GFX_CANVAS_H_
 
+#include <stdint.h>
+
+#include <functional>
 #include <memory>
 
 #include "base/memory/ref_counted.h"
+#include "nativeui/gfx/geometry/rect.h"
 #include "nativeui/gfx/geometry/size_f.h"
 #include "nativeui/nativeui_export.h"
 #include "nativeui/types.h"
 
 namespace nu {
 
+class Lifetime;
 class Painter;
 
 class NATIVEUI_EXPORT Canvas : public base::RefCounted<Canvas> {
  public:
+  // The memory of pixels, each pixel is a premultiplied ARGB value stored as
+  // uint32_t in native byte order, and rows are |stride| bytes apart. The
+  // format is the same on all platforms.
+  struct PixelBuffer {
+    uint8_t* data = nullptr;
+    int width = 0;
+    int height = 0;
+    int stride = 0;
+  };
+
   // Create a canvas with the default scale factor.
   // This is strongly discouraged for using, since it does not work well with
   // multi-monitor setup, but honestly I don't know whether there is a good
@@ -26,6 +41,14 @@ class NATIVEUI_EXPORT Canvas : public base::RefCounted<Canvas> {
   // Create a canvas with |scale_factor|.
   Canvas(const SizeF& size, float scale_factor);
 
+  // Create a canvas that paints on |pixels| directly without copying them.
+  // The memory is owned by caller and must be kept alive until the canvas is
+  // destroyed, when |release| is called.
+  static Canvas* CreateFromPixels(const PixelBuffer& pixels,
+                                  float scale_factor,
+                                  const std::function<void()>& release =
+                                      nullptr);
+
   // Return the independent scale factor of canvas.
   float GetScaleFactor() const { return scale_factor_; }
 
@@ -35,6 +58,28 @@ class NATIVEUI_EXPORT Canvas : public base::RefCounted<Canvas> {
   // Return the size of canvas.
   SizeF GetSize() const { return size_; }
 
+  // Get direct access to the pixels. Painting with the painter is not allowed
+  // until the pixels are unlocked.
+  PixelBuffer LockPixels();
+
+  // Finish accessing the pixels, |dirty| is the changed area in pixels.
+  void UnlockPixels(const Rect& dirty);
+  void UnlockPixels();
+
+  // Return whether the pixels are locked.
+  bool IsPixelsLocked() const { return pixels_locked_; }
+
+  // Run |paint| with a private painter on a worker thread, and call |done| on
+  // current thread after painting. The canvas must not be painted, locked or
+  // drawn until |done| is called. The |paint| is destroyed on the worker
+  // thread, and must not use objects that are being used by other threads.
+  using PaintCallback = std::function<void(Painter*)>;
+  void PaintAsync(const PaintCallback& paint,
+                  const std::function<void()>& done);
+
+  // Return whether the canvas is being painted by PaintAsync.
+  bool IsPainting() const { return painting_; }
+
   // Internal: Return the native bitmap object.
   NativeBitmap GetBitmap() const { return bitmap_; }
 
@@ -44,18 +89,41 @@ class NATIVEUI_EXPORT Canvas : public base::RefCounted<Canvas> {
  private:
   friend class base::RefCounted<Canvas>;
 
+  Canvas(const PixelBuffer& pixels, float scale_factor);
+
+  void PaintOnWorker(const PaintCallback& paint, Lifetime* lifetime);
+  void FinishPaintAsync();
+
   // Platform implementations.
   static NativeBitmap PlatformCreateBitmap(const SizeF& size,
                                            float scale_factor);
+  static NativeBitmap PlatformCreateBitmapFromPixels(const PixelBuffer& pixels,
+                                                     float scale_factor);
   static void PlatformDestroyBitmap(NativeBitmap bitmap);
   static Painter* PlatformCreatePainter(NativeBitmap bitmap,
                                         float scale_factor);
+  PixelBuffer PlatformLockPixels();
+  void PlatformUnlockPixels(const Rect& dirty);
 
   float scale_factor_;
   SizeF size_;
 
   NativeBitmap bitmap_;
   std::unique_ptr<Painter> painter_;
+
+  bool pixels_locked_ = false;
+
+  // Called after destroying the bitmap of caller-owned pixels.
+  std::function<void()> release_pixels_;
+
+  // The state of running PaintAsync.
+  bool painting_ = false;
+  std::function<void()> paint_done_;
+
+#if defined(OS_WIN)
+  // The locked bits of bitmap.
+  std::unique_ptr<Gdiplus::BitmapData> bitmap_data_;
+#endif
 };
 
 }  // namespace nu
@@ -0,0 +1,91 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <vector>
+
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class CanvasTest : public testing::Test {
+ protected:
+  nu::Lifetime lifetime_;
+  nu::State state_;
+};
+
+TEST_F(CanvasTest, LockPixels) {
+  scoped_refptr<nu::Canvas> canvas(new nu::Canvas(nu::SizeF(10, 20), 2.f));
+  nu::Canvas::PixelBuffer pixels = canvas->LockPixels();
+  EXPECT_TRUE(canvas->IsPixelsLocked());
+  ASSERT_NE(pixels.data, nullptr);
+  EXPECT_EQ(pixels.width, 20);
+  EXPECT_EQ(pixels.height, 40);
+  EXPECT_GE(pixels.stride, pixels.width * 4);
+  *reinterpret_cast<uint32_t*>(pixels.data) = 0xFF00FF00;
+  canvas->UnlockPixels(nu::Rect(0, 0, 1, 1));
+  EXPECT_FALSE(canvas->IsPixelsLocked());
+
+  // The pixels are kept after painting.
+  canvas->GetPainter()->FillRect(nu::RectF(5, 5, 1, 1));
+  pixels = canvas->LockPixels();
+  EXPECT_EQ(*reinterpret_cast<uint32_t*>(pixels.data), 0xFF00FF00);
+  canvas->UnlockPixels();
+}
+
+TEST_F(CanvasTest, CreateFromPixels) {
+  const int kWidth = 8;
+  const int kHeight = 4;
+  std::vector<uint32_t> memory(kWidth * kHeight, 0);
+  nu::Canvas::PixelBuffer pixels;
+  pixels.data = reinterpret_cast<uint8_t*>(memory.data());
+  pixels.width = kWidth;
+  pixels.height = kHeight;
+  pixels.stride = kWidth * 4;
+  scoped_refptr<nu::Canvas> canvas(
+      nu::Canvas::CreateFromPixels(pixels, 1.f));
+  EXPECT_EQ(canvas->GetSize(), nu::SizeF(kWidth, kHeight));
+
+  // Painting writes to the memory directly.
+  nu::Painter* painter = canvas->GetPainter();
+  painter->SetFillColor(nu::Color(255, 0, 0));
+  painter->FillRect(nu::RectF(0, 0, kWidth, kHeight));
+  nu::Canvas::PixelBuffer locked = canvas->LockPixels();
+  EXPECT_EQ(locked.stride, pixels.stride);
+  EXPECT_EQ(memory[0], 0xFFFF0000);
+  EXPECT_EQ(memory[kWidth * kHeight - 1], 0xFFFF0000);
+  canvas->UnlockPixels();
+}
+
+TEST_F(CanvasTest, ReleasePixels) {
+  std::vector<uint32_t> memory(4 * 4, 0);
+  nu::Canvas::PixelBuffer pixels;
+  pixels.data = reinterpret_cast<uint8_t*>(memory.data());
+  pixels.width = 4;
+  pixels.height = 4;
+  pixels.stride = 4 * 4;
+  bool released = false;
+  scoped_refptr<nu::Canvas> canvas(nu::Canvas::CreateFromPixels(
+      pixels, 1.f, [&released]() { released = true; }));
+  EXPECT_FALSE(released);
+  canvas = nullptr;
+  EXPECT_TRUE(released);
+}
+
+TEST_F(CanvasTest, PaintAsync) {
+  scoped_refptr<nu::Canvas> canvas(new nu::Canvas(nu::SizeF(4, 4), 1.f));
+  bool done = false;
+  canvas->PaintAsync([](nu::Painter* painter) {
+    painter->SetFillColor(nu::Color(255, 0, 0));
+    painter->FillRect(nu::RectF(0, 0, 4, 4));
+  }, [&]() {
+    done = true;
+    lifetime_.Quit();
+  });
+  EXPECT_TRUE(canvas->IsPainting());
+  lifetime_.Run();
+  EXPECT_TRUE(done);
+  EXPECT_FALSE(canvas->IsPainting());
+  nu::Canvas::PixelBuffer pixels = canvas->LockPixels();
+  EXPECT_EQ(*reinterpret_cast<uint32_t*>(pixels.data), 0xFFFF0000);
+  canvas->UnlockPixels();
+}
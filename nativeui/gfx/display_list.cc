@@ -0,0 +1,375 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/display_list.h"
+
+#include "nativeui/gfx/canvas.h"
+#include "nativeui/gfx/image.h"
+#include "nativeui/gfx/path.h"
+
+namespace nu {
+
+// Reads the arguments of commands in the order they were recorded.
+class DisplayList::Reader {
+ public:
+  explicit Reader(const DisplayList* list) : list_(list) {}
+
+  float ReadFloat() { return list_->floats_[float_index_++]; }
+  PointF ReadPoint() {
+    float x = ReadFloat();
+    return PointF(x, ReadFloat());
+  }
+  RectF ReadRect() {
+    float x = ReadFloat();
+    float y = ReadFloat();
+    float width = ReadFloat();
+    return RectF(x, y, width, ReadFloat());
+  }
+  Color ReadColor() { return list_->colors_[color_index_++]; }
+  Image* ReadImage() { return list_->images_[image_index_++].get(); }
+  Canvas* ReadCanvas() { return list_->canvases_[canvas_index_++].get(); }
+  Path* ReadPath() { return list_->paths_[path_index_++].get(); }
+  const std::string& ReadText() { return list_->texts_[text_index_++]; }
+  const TextAttributes& ReadAttributes() {
+    return list_->attributes_[attributes_index_++];
+  }
+
+ private:
+  const DisplayList* list_;
+  size_t float_index_ = 0;
+  size_t color_index_ = 0;
+  size_t image_index_ = 0;
+  size_t canvas_index_ = 0;
+  size_t path_index_ = 0;
+  size_t text_index_ = 0;
+  size_t attributes_index_ = 0;
+};
+
+DisplayList::DisplayList() {}
+
+DisplayList::~DisplayList() {}
+
+void DisplayList::Replay(Painter* painter) const {
+  Reader r(this);
+  for (Op op : ops_) {
+    switch (op) {
+      case Op::Save:
+        painter->Save();
+        break;
+      case Op::Restore:
+        painter->Restore();
+        break;
+      case Op::BeginPath:
+        painter->BeginPath();
+        break;
+      case Op::ClosePath:
+        painter->ClosePath();
+        break;
+      case Op::MoveTo:
+        painter->MoveTo(r.ReadPoint());
+        break;
+      case Op::LineTo:
+        painter->LineTo(r.ReadPoint());
+        break;
+      case Op::BezierCurveTo: {
+        PointF cp1 = r.ReadPoint();
+        PointF cp2 = r.ReadPoint();
+        painter->BezierCurveTo(cp1, cp2, r.ReadPoint());
+        break;
+      }
+      case Op::Arc: {
+        PointF point = r.ReadPoint();
+        float radius = r.ReadFloat();
+        float sa = r.ReadFloat();
+        painter->Arc(point, radius, sa, r.ReadFloat());
+        break;
+      }
+      case Op::Rect:
+        painter->Rect(r.ReadRect());
+        break;
+      case Op::Clip:
+        painter->Clip();
+        break;
+      case Op::ClipRect:
+        painter->ClipRect(r.ReadRect());
+        break;
+      case Op::Translate: {
+        float x = r.ReadFloat();
+        painter->Translate(Vector2dF(x, r.ReadFloat()));
+        break;
+      }
+      case Op::Rotate:
+        painter->Rotate(r.ReadFloat());
+        break;
+      case Op::Scale: {
+        float x = r.ReadFloat();
+        painter->Scale(Vector2dF(x, r.ReadFloat()));
+        break;
+      }
+      case Op::SetColor:
+        painter->SetColor(r.ReadColor());
+        break;
+      case Op::SetStrokeColor:
+        painter->SetStrokeColor(r.ReadColor());
+        break;
+      case Op::SetFillColor:
+        painter->SetFillColor(r.ReadColor());
+        break;
+      case Op::SetLineWidth:
+        painter->SetLineWidth(r.ReadFloat());
+        break;
+      case Op::Stroke:
+        painter->Stroke();
+        break;
+      case Op::Fill:
+        painter->Fill();
+        break;
+      case Op::StrokePath:
+        painter->StrokePath(r.ReadPath());
+        break;
+      case Op::FillPath:
+        painter->FillPath(r.ReadPath());
+        break;
+      case Op::ClipPath:
+        painter->ClipPath(r.ReadPath());
+        break;
+      case Op::StrokeRect:
+        painter->StrokeRect(r.ReadRect());
+        break;
+      case Op::FillRect:
+        painter->FillRect(r.ReadRect());
+        break;
+      case Op::DrawImage: {
+        Image* image = r.ReadImage();
+        painter->DrawImage(image, r.ReadRect());
+        break;
+      }
+      case Op::DrawImageFromRect: {
+        Image* image = r.ReadImage();
+        RectF src = r.ReadRect();
+        painter->DrawImageFromRect(image, src, r.ReadRect());
+        break;
+      }
+      case Op::DrawCanvas: {
+        Canvas* canvas = r.ReadCanvas();
+        painter->DrawCanvas(canvas, r.ReadRect());
+        break;
+      }
+      case Op::DrawCanvasFromRect: {
+        Canvas* canvas = r.ReadCanvas();
+        RectF src = r.ReadRect();
+        painter->DrawCanvasFromRect(canvas, src, r.ReadRect());
+        break;
+      }
+      case Op::DrawText: {
+        const std::string& text = r.ReadText();
+        RectF rect = r.ReadRect();
+        painter->DrawText(text, rect, r.ReadAttributes());
+        break;
+      }
+    }
+  }
+}
+
+void DisplayList::Clear() {
+  ops_.clear();
+  floats_.clear();
+  colors_.clear();
+  images_.clear();
+  canvases_.clear();
+  paths_.clear();
+  texts_.clear();
+  attributes_.clear();
+}
+
+void DisplayList::Save() {
+  ops_.push_back(Op::Save);
+}
+
+void DisplayList::Restore() {
+  ops_.push_back(Op::Restore);
+}
+
+void DisplayList::BeginPath() {
+  ops_.push_back(Op::BeginPath);
+}
+
+void DisplayList::ClosePath() {
+  ops_.push_back(Op::ClosePath);
+}
+
+void DisplayList::MoveTo(const PointF& p) {
+  ops_.push_back(Op::MoveTo);
+  PushPoint(p);
+}
+
+void DisplayList::LineTo(const PointF& p) {
+  ops_.push_back(Op::LineTo);
+  PushPoint(p);
+}
+
+void DisplayList::BezierCurveTo(const PointF& cp1,
+                                const PointF& cp2,
+                                const PointF& ep) {
+  ops_.push_back(Op::BezierCurveTo);
+  PushPoint(cp1);
+  PushPoint(cp2);
+  PushPoint(ep);
+}
+
+void DisplayList::Arc(const PointF& point, float radius, float sa, float ea) {
+  ops_.push_back(Op::Arc);
+  PushPoint(point);
+  floats_.push_back(radius);
+  floats_.push_back(sa);
+  floats_.push_back(ea);
+}
+
+void DisplayList::Rect(const RectF& rect) {
+  ops_.push_back(Op::Rect);
+  PushRect(rect);
+}
+
+void DisplayList::Clip() {
+  ops_.push_back(Op::Clip);
+}
+
+void DisplayList::ClipRect(const RectF& rect) {
+  ops_.push_back(Op::ClipRect);
+  PushRect(rect);
+}
+
+bool DisplayList::QuickReject(const RectF& rect) {
+  // The recorded commands may be replayed with any clip.
+  return false;
+}
+
+void DisplayList::Translate(const Vector2dF& offset) {
+  ops_.push_back(Op::Translate);
+  floats_.push_back(offset.x());
+  floats_.push_back(offset.y());
+}
+
+void DisplayList::Rotate(float angle) {
+  ops_.push_back(Op::Rotate);
+  floats_.push_back(angle);
+}
+
+void DisplayList::Scale(const Vector2dF& scale) {
+  ops_.push_back(Op::Scale);
+  floats_.push_back(scale.x());
+  floats_.push_back(scale.y());
+}
+
+void DisplayList::SetColor(Color color) {
+  ops_.push_back(Op::SetColor);
+  colors_.push_back(color);
+}
+
+void DisplayList::SetStrokeColor(Color color) {
+  ops_.push_back(Op::SetStrokeColor);
+  colors_.push_back(color);
+}
+
+void DisplayList::SetFillColor(Color color) {
+  ops_.push_back(Op::SetFillColor);
+  colors_.push_back(color);
+}
+
+void DisplayList::SetLineWidth(float width) {
+  ops_.push_back(Op::SetLineWidth);
+  floats_.push_back(width);
+}
+
+void DisplayList::Stroke() {
+  ops_.push_back(Op::Stroke);
+}
+
+void DisplayList::Fill() {
+  ops_.push_back(Op::Fill);
+}
+
+// The paths are copied since they can be changed after being recorded.
+void DisplayList::StrokePath(Path* path) {
+  ops_.push_back(Op::StrokePath);
+  paths_.push_back(path->Clone());
+}
+
+void DisplayList::FillPath(Path* path) {
+  ops_.push_back(Op::FillPath);
+  paths_.push_back(path->Clone());
+}
+
+void DisplayList::ClipPath(Path* path) {
+  ops_.push_back(Op::ClipPath);
+  paths_.push_back(path->Clone());
+}
+
+void DisplayList::StrokeRect(const RectF& rect) {
+  ops_.push_back(Op::StrokeRect);
+  PushRect(rect);
+}
+
+void DisplayList::FillRect(const RectF& rect) {
+  ops_.push_back(Op::FillRect);
+  PushRect(rect);
+}
+
+void DisplayList::DrawImage(Image* image, const RectF& rect) {
+  ops_.push_back(Op::DrawImage);
+  images_.push_back(image);
+  PushRect(rect);
+}
+
+void DisplayList::DrawImageFromRect(Image* image, const RectF& src,
+                                    const RectF& dest) {
+  ops_.push_back(Op::DrawImageFromRect);
+  images_.push_back(image);
+  PushRect(src);
+  PushRect(dest);
+}
+
+void DisplayList::DrawCanvas(Canvas* canvas, const RectF& rect) {
+  ops_.push_back(Op::DrawCanvas);
+  canvases_.push_back(canvas);
+  PushRect(rect);
+}
+
+void DisplayList::DrawCanvasFromRect(Canvas* canvas, const RectF& src,
+                                     const RectF& dest) {
+  ops_.push_back(Op::DrawCanvasFromRect);
+  canvases_.push_back(canvas);
+  PushRect(src);
+  PushRect(dest);
+}
+
+TextMetrics DisplayList::MeasureText(const std::string& text, float width,
+                                     const TextAttributes& attributes) {
+  if (measure_painter_)
+    return measure_painter_->MeasureText(text, width, attributes);
+  scoped_refptr<Canvas> canvas(new Canvas(SizeF(1, 1)));
+  return canvas->GetPainter()->MeasureText(text, width, attributes);
+}
+
+void DisplayList::DrawText(const std::string& text, const RectF& rect,
+                           const TextAttributes& attributes) {
+  ops_.push_back(Op::DrawText);
+  texts_.push_back(text);
+  PushRect(rect);
+  attributes_.push_back(attributes);
+}
+
+void DisplayList::PushPoint(const PointF& point) {
+  floats_.push_back(point.x());
+  floats_.push_back(point.y());
+}
+
+void DisplayList::PushRect(const RectF& rect) {
+  floats_.push_back(rect.x());
+  floats_.push_back(rect.y());
+  floats_.push_back(rect.width());
+  floats_.push_back(rect.height());
+}
+
+}  // namespace nu
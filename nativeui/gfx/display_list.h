@@ -0,0 +1,134 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_GFX_DISPLAY_LIST_H_
+#define NATIVEUI_GFX_DISPLAY_LIST_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "nativeui/gfx/painter.h"
+
+namespace nu {
+
+// A Painter that records the painting commands instead of drawing them, the
+// recorded commands can then be replayed on other painters.
+class NATIVEUI_EXPORT DisplayList : public Painter {
+ public:
+  DisplayList();
+  ~DisplayList() override;
+
+  // Paint the recorded commands on |painter|.
+  void Replay(Painter* painter) const;
+
+  // Remove all recorded commands.
+  void Clear();
+
+  // Return the number of recorded commands.
+  size_t size() const { return ops_.size(); }
+
+  // Text can not be measured without a real painter, |painter| is used for
+  // measuring text while recording. When it is not set, a temporary canvas is
+  // used instead.
+  void set_measure_painter(Painter* painter) { measure_painter_ = painter; }
+
+  // Painter:
+  void Save() override;
+  void Restore() override;
+  void BeginPath() override;
+  void ClosePath() override;
+  void MoveTo(const PointF& p) override;
+  void LineTo(const PointF& p) override;
+  void BezierCurveTo(const PointF& cp1,
+                     const PointF& cp2,
+                     const PointF& ep) override;
+  void Arc(const PointF& point, float radius, float sa, float ea) override;
+  void Rect(const RectF& rect) override;
+  void Clip() override;
+  void ClipRect(const RectF& rect) override;
+  bool QuickReject(const RectF& rect) override;
+  void Translate(const Vector2dF& offset) override;
+  void Rotate(float angle) override;
+  void Scale(const Vector2dF& scale) override;
+  void SetColor(Color color) override;
+  void SetStrokeColor(Color color) override;
+  void SetFillColor(Color color) override;
+  void SetLineWidth(float width) override;
+  void Stroke() override;
+  void Fill() override;
+  void StrokePath(Path* path) override;
+  void FillPath(Path* path) override;
+  void ClipPath(Path* path) override;
+  void StrokeRect(const RectF& rect) override;
+  void FillRect(const RectF& rect) override;
+  void DrawImage(Image* image, const RectF& rect) override;
+  void DrawImageFromRect(Image* image, const RectF& src,
+                         const RectF& dest) override;
+  void DrawCanvas(Canvas* canvas, const RectF& rect) override;
+  void DrawCanvasFromRect(Canvas* canvas, const RectF& src,
+                          const RectF& dest) override;
+  TextMetrics MeasureText(const std::string& text, float width,
+                          const TextAttributes& attributes) override;
+  void DrawText(const std::string& text, const RectF& rect,
+                const TextAttributes& attributes) override;
+
+ private:
+  enum class Op : uint8_t {
+    Save,
+    Restore,
+    BeginPath,
+    ClosePath,
+    MoveTo,
+    LineTo,
+    BezierCurveTo,
+    Arc,
+    Rect,
+    Clip,
+    ClipRect,
+    Translate,
+    Rotate,
+    Scale,
+    SetColor,
+    SetStrokeColor,
+    SetFillColor,
+    SetLineWidth,
+    Stroke,
+    Fill,
+    StrokePath,
+    FillPath,
+    ClipPath,
+    StrokeRect,
+    FillRect,
+    DrawImage,
+    DrawImageFromRect,
+    DrawCanvas,
+    DrawCanvasFromRect,
+    DrawText,
+  };
+
+  class Reader;
+
+  void PushPoint(const PointF& point);
+  void PushRect(const RectF& rect);
+
+  // The commands, and their arguments stored in the order of commands.
+  std::vector<Op> ops_;
+  std::vector<float> floats_;
+  std::vector<Color> colors_;
+  std::vector<scoped_refptr<Image>> images_;
+  std::vector<scoped_refptr<Canvas>> canvases_;
+  std::vector<scoped_refptr<Path>> paths_;
+  std::vector<std::string> texts_;
+  std::vector<TextAttributes> attributes_;
+
+  Painter* measure_painter_ = nullptr;
+
+  DISALLOW_COPY_AND_ASSIGN(DisplayList);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_GFX_DISPLAY_LIST_H_
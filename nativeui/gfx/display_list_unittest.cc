@@ -0,0 +1,46 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/display_list.h"
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class DisplayListTest : public testing::Test {
+ protected:
+  nu::Lifetime lifetime_;
+  nu::State state_;
+};
+
+TEST_F(DisplayListTest, RecordAndReplay) {
+  nu::DisplayList list;
+  list.Save();
+  list.SetFillColor(nu::Color(255, 0, 0));
+  list.BeginPath();
+  list.Arc(nu::PointF(10, 10), 5, 0, 3.14f);
+  list.Fill();
+  list.DrawText("text", nu::RectF(0, 0, 100, 20), nu::TextAttributes());
+  list.Restore();
+  EXPECT_EQ(list.size(), 7u);
+
+  nu::DisplayList copy;
+  list.Replay(&copy);
+  EXPECT_EQ(copy.size(), 7u);
+
+  // Replay on a real painter.
+  scoped_refptr<nu::Canvas> canvas(new nu::Canvas(nu::SizeF(100, 100)));
+  copy.Replay(canvas->GetPainter());
+
+  list.Clear();
+  EXPECT_EQ(list.size(), 0u);
+}
+
+TEST_F(DisplayListTest, MeasureText) {
+  nu::DisplayList list;
+  nu::TextAttributes attributes(nu::App::GetCurrent()->GetDefaultFont(),
+                                nu::Color(), nu::TextAlign::Start,
+                                nu::TextAlign::Start);
+  nu::TextMetrics metrics = list.MeasureText("text", -1, attributes);
+  EXPECT_GT(metrics.size.width(), 0);
+  EXPECT_EQ(list.size(), 0u);
+}
@@ -0,0 +1,17 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/font.h"
+
+namespace nu {
+
+const FontMetrics& Font::GetMetrics() const {
+  if (!has_metrics_) {
+    metrics_ = PlatformGetMetrics();
+    has_metrics_ = true;
+  }
+  return metrics_;
+}
+
+}  // namespace nu
@@ -13,6 +13,13 @@
 
 namespace nu {
 
+// The metrics of a font in DIPs.
+struct FontMetrics {
+  float ascent = 0;
+  float descent = 0;
+  float average_char_width = 0;
+};
+
 class NATIVEUI_EXPORT Font : public base::RefCounted<Font> {
  public:
   // Standard font weights as used in Pango and Windows. The values must match
@@ -53,6 +60,9 @@ class NATIVEUI_EXPORT Font : public base::RefCounted<Font> {
   // Return the font style.
   Style GetStyle() const;
 
+  // Return the metrics of the font, which are computed on first call.
+  const FontMetrics& GetMetrics() const;
+
   // Return the native font handle.
   NativeFont GetNative() const;
 
@@ -62,7 +72,12 @@ class NATIVEUI_EXPORT Font : public base::RefCounted<Font> {
  private:
   friend class base::RefCounted<Font>;
 
+  FontMetrics PlatformGetMetrics() const;
+
   NativeFont font_;
+
+  mutable bool has_metrics_ = false;
+  mutable FontMetrics metrics_;
 };
 
 }  // namespace nu
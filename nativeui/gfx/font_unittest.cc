@@ -0,0 +1,55 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class FontTest : public testing::Test {
+ protected:
+  nu::Lifetime lifetime_;
+  nu::State state_;
+};
+
+TEST_F(FontTest, DefaultFont) {
+  nu::FontRegistry* registry = state_.font_registry();
+  EXPECT_EQ(registry->GetDefaultFont(), registry->GetDefaultFont());
+  EXPECT_EQ(nu::App::GetCurrent()->GetDefaultFont(),
+            registry->GetDefaultFont());
+}
+
+TEST_F(FontTest, InternFonts) {
+  nu::FontRegistry* registry = state_.font_registry();
+  scoped_refptr<nu::Font> f1 = registry->GetFont(
+      "Arial", 12, nu::Font::Weight::Normal, nu::Font::Style::Normal);
+  scoped_refptr<nu::Font> f2 = registry->GetFont(
+      "Arial", 12, nu::Font::Weight::Normal, nu::Font::Style::Normal);
+  scoped_refptr<nu::Font> f3 = registry->GetFont(
+      "Arial", 12, nu::Font::Weight::Bold, nu::Font::Style::Normal);
+  EXPECT_EQ(f1, f2);
+  EXPECT_NE(f1, f3);
+  EXPECT_EQ(registry->size(), 2u);
+
+  // Only unused fonts are purged.
+  f3 = nullptr;
+  registry->Purge();
+  EXPECT_EQ(registry->size(), 1u);
+}
+
+TEST_F(FontTest, PurgeAutomatically) {
+  nu::FontRegistry* registry = state_.font_registry();
+  for (int i = 0; i < 100; ++i) {
+    scoped_refptr<nu::Font> font = registry->GetFont(
+        "Arial", 10 + i, nu::Font::Weight::Normal, nu::Font::Style::Normal);
+  }
+  EXPECT_LT(registry->size(), 100u);
+}
+
+TEST_F(FontTest, GetMetrics) {
+  nu::Font* font = nu::App::GetCurrent()->GetDefaultFont();
+  const nu::FontMetrics& metrics = font->GetMetrics();
+  EXPECT_GT(metrics.ascent, 0);
+  EXPECT_GT(metrics.descent, 0);
+  EXPECT_GT(metrics.average_char_width, 0);
+  EXPECT_EQ(&metrics, &font->GetMetrics());
+}
@@ -19,6 +19,16 @@ NativeBitmap Canvas::PlatformCreateBitmap(const SizeF& size,
   return surface;
 }
 
+// static
+NativeBitmap Canvas::PlatformCreateBitmapFromPixels(const PixelBuffer& pixels,
+                                                    float scale_factor) {
+  cairo_surface_t* surface = cairo_image_surface_create_for_data(
+      pixels.data, CAIRO_FORMAT_ARGB32, pixels.width, pixels.height,
+      pixels.stride);
+  cairo_surface_set_device_scale(surface, scale_factor, scale_factor);
+  return surface;
+}
+
 // static
 void Canvas::PlatformDestroyBitmap(NativeBitmap bitmap) {
   cairo_surface_destroy(bitmap);
@@ -30,4 +40,21 @@ Painter* Canvas::PlatformCreatePainter(NativeBitmap bitmap,
   return new PainterGtk(bitmap, scale_factor);
 }
 
+Canvas::PixelBuffer Canvas::PlatformLockPixels() {
+  // Make sure all pending drawing operations are finished.
+  cairo_surface_flush(bitmap_);
+  PixelBuffer pixels;
+  pixels.data = cairo_image_surface_get_data(bitmap_);
+  pixels.width = cairo_image_surface_get_width(bitmap_);
+  pixels.height = cairo_image_surface_get_height(bitmap_);
+  pixels.stride = cairo_image_surface_get_stride(bitmap_);
+  return pixels;
+}
+
+void Canvas::PlatformUnlockPixels(const Rect& dirty) {
+  // Tell cairo to discard the cached copies of the changed area.
+  cairo_surface_mark_dirty_rectangle(bitmap_, dirty.x(), dirty.y(),
+                                     dirty.width(), dirty.height());
+}
+
 }  // namespace nu
@@ -66,4 +66,22 @@ NativeFont Font::GetNative() const {
   return font_;
 }
 
+FontMetrics Font::PlatformGetMetrics() const {
+  PangoContext* context =
+      pango_font_map_create_context(pango_cairo_font_map_get_default());
+  PangoFontMetrics* metrics = pango_context_get_metrics(context, font_,
+                                                        nullptr);
+  FontMetrics result;
+  result.ascent =
+      static_cast<float>(pango_font_metrics_get_ascent(metrics)) / PANGO_SCALE;
+  result.descent =
+      static_cast<float>(pango_font_metrics_get_descent(metrics)) / PANGO_SCALE;
+  result.average_char_width =
+      static_cast<float>(pango_font_metrics_get_approximate_char_width(
+          metrics)) / PANGO_SCALE;
+  pango_font_metrics_unref(metrics);
+  g_object_unref(context);
+  return result;
+}
+
 }  // namespace nu
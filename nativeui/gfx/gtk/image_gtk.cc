@@ -6,11 +6,20 @@
 
 #include <gtk/gtk.h>
 
+#include <algorithm>
+
 namespace nu {
 
+namespace {
+
+// Number of resized surfaces kept for each image.
+const size_t kMaxScaledSurfaces = 2;
+
+}  // namespace
+
 Image::Image(const base::FilePath& path)
-    : scale_factor_(GetScaleFactorFromFilePath(path)),
-      image_(gdk_pixbuf_new_from_file(path.value().c_str(), nullptr)) {
+    : scale_factor_(1.f),
+      image_(PlatformDecodeFile(path, &scale_factor_)) {
   // When file reading failed |image_| could be nullptr, having a null
   // native image is very dangerous so we create an empty image when it
   // happens.
@@ -19,6 +28,11 @@ Image::Image(const base::FilePath& path)
 }
 
 Image::~Image() {
+  SetMipmapped(false);
+  for (const ScaledSurface& scaled : scaled_surfaces_)
+    cairo_surface_destroy(scaled.surface);
+  if (surface_)
+    cairo_surface_destroy(surface_);
   g_object_unref(image_);
 }
 
@@ -28,8 +42,142 @@ SizeF Image::GetSize() const {
                    1.f / scale_factor_);
 }
 
+void Image::SetMipmapped(bool mipmapped) {
+  base::AutoLock auto_lock(lock_);
+  mipmapped_ = mipmapped;
+  if (!mipmapped) {
+    for (cairo_surface_t* surface : mipmaps_)
+      cairo_surface_destroy(surface);
+    mipmaps_.clear();
+  }
+}
+
 NativeImage Image::GetNative() const {
   return image_;
 }
 
+cairo_surface_t* Image::GetCairoSurface() {
+  base::AutoLock auto_lock(lock_);
+  return cairo_surface_reference(GetCairoSurfaceLocked());
+}
+
+cairo_surface_t* Image::GetScaledCairoSurface(const Size& size) {
+  base::AutoLock auto_lock(lock_);
+  for (auto it = scaled_surfaces_.begin(); it != scaled_surfaces_.end(); ++it) {
+    if (it->size == size) {
+      ScaledSurface scaled = *it;
+      scaled_surfaces_.erase(it);
+      scaled_surfaces_.insert(scaled_surfaces_.begin(), scaled);
+      return cairo_surface_reference(scaled.surface);
+    }
+  }
+
+  // Resizing from the closest mipmap level is much cheaper.
+  cairo_surface_t* source = mipmapped_ ? GetMipmapCairoSurfaceLocked(size)
+                                       : GetCairoSurfaceLocked();
+  cairo_surface_t* surface = cairo_surface_create_similar_image(
+      source, cairo_image_surface_get_format(source),
+      size.width(), size.height());
+  cairo_t* cr = cairo_create(surface);
+  cairo_scale(cr,
+              static_cast<double>(size.width()) /
+                  cairo_image_surface_get_width(source),
+              static_cast<double>(size.height()) /
+                  cairo_image_surface_get_height(source));
+  cairo_set_source_surface(cr, source, 0, 0);
+  cairo_pattern_set_filter(cairo_get_source(cr), CAIRO_FILTER_GOOD);
+  cairo_paint(cr);
+  cairo_destroy(cr);
+
+  if (scaled_surfaces_.size() == kMaxScaledSurfaces) {
+    cairo_surface_destroy(scaled_surfaces_.back().surface);
+    scaled_surfaces_.pop_back();
+  }
+  scaled_surfaces_.insert(scaled_surfaces_.begin(), {size, surface});
+  return cairo_surface_reference(surface);
+}
+
+cairo_surface_t* Image::GetMipmapCairoSurface(const Size& size) {
+  base::AutoLock auto_lock(lock_);
+  return cairo_surface_reference(GetMipmapCairoSurfaceLocked(size));
+}
+
+cairo_surface_t* Image::GetCairoSurfaceLocked() {
+  if (!surface_)
+    surface_ = gdk_cairo_surface_create_from_pixbuf(image_, 1, nullptr);
+  return surface_;
+}
+
+cairo_surface_t* Image::GetMipmapCairoSurfaceLocked(const Size& size) {
+  cairo_surface_t* level = GetCairoSurfaceLocked();
+  for (size_t i = 0; ; ++i) {
+    int width = cairo_image_surface_get_width(level) / 2;
+    int height = cairo_image_surface_get_height(level) / 2;
+    if (width < std::max(size.width(), 1) ||
+        height < std::max(size.height(), 1))
+      return level;
+    if (i == mipmaps_.size()) {
+      // Each level is downscaled from previous one, which averages 2x2 pixels.
+      cairo_surface_t* next = cairo_surface_create_similar_image(
+          level, cairo_image_surface_get_format(level), width, height);
+      cairo_t* cr = cairo_create(next);
+      cairo_scale(cr,
+                  static_cast<double>(width) /
+                      cairo_image_surface_get_width(level),
+                  static_cast<double>(height) /
+                      cairo_image_surface_get_height(level));
+      cairo_set_source_surface(cr, level, 0, 0);
+      cairo_pattern_set_filter(cairo_get_source(cr), CAIRO_FILTER_GOOD);
+      cairo_paint(cr);
+      cairo_destroy(cr);
+      mipmaps_.push_back(next);
+    }
+    level = mipmaps_[i];
+  }
+}
+
+// static
+NativeImage Image::PlatformDecodeBuffer(const void* data, size_t size,
+                                        float scale_factor) {
+  // The loader decodes the data as it is written, without keeping a copy.
+  GdkPixbufLoader* loader = gdk_pixbuf_loader_new();
+  bool written = gdk_pixbuf_loader_write(
+      loader, static_cast<const guchar*>(data), size, nullptr);
+  // The loader must always be closed before being destroyed.
+  bool closed = gdk_pixbuf_loader_close(loader, nullptr);
+  GdkPixbuf* pixbuf = nullptr;
+  if (written && closed) {
+    pixbuf = gdk_pixbuf_loader_get_pixbuf(loader);
+    if (pixbuf)
+      g_object_ref(pixbuf);
+  }
+  g_object_unref(loader);
+  return pixbuf;
+}
+
+// static
+NativeImage Image::PlatformDecodeFile(const base::FilePath& path,
+                                      float* scale_factor) {
+  *scale_factor = GetScaleFactorFromFilePath(path);
+  return gdk_pixbuf_new_from_file(path.value().c_str(), nullptr);
+}
+
+// static
+NativeImage Image::PlatformDecodeFileAtSize(const base::FilePath& path,
+                                            const Size& size,
+                                            float scale_factor) {
+  // Only the header is read for getting the size.
+  int width, height;
+  if (!gdk_pixbuf_get_file_info(path.value().c_str(), &width, &height))
+    return nullptr;
+  Size fit_size = GetFitSize(Size(width, height), size);
+  if (fit_size == Size(width, height))
+    return gdk_pixbuf_new_from_file(path.value().c_str(), nullptr);
+  // The loader decodes the image at the scaled size directly, which is much
+  // faster for formats like JPEG.
+  return gdk_pixbuf_new_from_file_at_scale(path.value().c_str(),
+                                           fit_size.width(), fit_size.height(),
+                                           false, nullptr);
+}
+
 }  // namespace nu
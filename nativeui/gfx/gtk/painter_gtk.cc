@@ -13,10 +13,94 @@
 
 #include "nativeui/gfx/canvas.h"
 #include "nativeui/gfx/font.h"
+#include "nativeui/gfx/gtk/pango_layout_cache.h"
 #include "nativeui/gfx/image.h"
+#include "nativeui/gfx/path.h"
+#include "nativeui/state.h"
 
 namespace nu {
 
+namespace {
+
+// Whether the transformation of |context| has no rotation or skew.
+bool IsAxisAligned(cairo_t* context) {
+  cairo_matrix_t matrix;
+  cairo_get_matrix(context, &matrix);
+  return matrix.xy == 0 && matrix.yx == 0;
+}
+
+// Return the size in device pixels of |size| drawn on |context|.
+SizeF GetDevicePixelSize(cairo_t* context, const SizeF& size) {
+  double wx = size.width(), wy = 0;
+  cairo_user_to_device_distance(context, &wx, &wy);
+  double hx = 0, hy = size.height();
+  cairo_user_to_device_distance(context, &hx, &hy);
+  double x_device_scale, y_device_scale;
+  cairo_surface_get_device_scale(cairo_get_group_target(context),
+                                 &x_device_scale, &y_device_scale);
+  return SizeF(hypot(wx, wy) * x_device_scale, hypot(hx, hy) * y_device_scale);
+}
+
+// Round the edges of |rect| to device pixels of |context|, so bitmaps drawn
+// in it are not resampled. Rotated or skewed drawing is not changed.
+RectF SnapToDevicePixels(cairo_t* context, const RectF& rect) {
+  if (!IsAxisAligned(context))
+    return rect;
+  double x_device_scale, y_device_scale;
+  cairo_surface_get_device_scale(cairo_get_group_target(context),
+                                 &x_device_scale, &y_device_scale);
+  double x1 = rect.x(), y1 = rect.y();
+  double x2 = rect.right(), y2 = rect.bottom();
+  cairo_user_to_device(context, &x1, &y1);
+  cairo_user_to_device(context, &x2, &y2);
+  x1 = round(x1 * x_device_scale) / x_device_scale;
+  y1 = round(y1 * y_device_scale) / y_device_scale;
+  x2 = round(x2 * x_device_scale) / x_device_scale;
+  y2 = round(y2 * y_device_scale) / y_device_scale;
+  cairo_device_to_user(context, &x1, &y1);
+  cairo_device_to_user(context, &x2, &y2);
+  return RectF(fmin(x1, x2), fmin(y1, y2), fabs(x2 - x1), fabs(y2 - y1));
+}
+
+// Gets the shaped text from the cache of current thread, or shapes it for
+// |context| when there is no State on current thread.
+class ScopedTextLayout {
+ public:
+  ScopedTextLayout(cairo_t* context, const std::string& text, Font* font,
+                   float width) {
+    State* state = State::GetCurrent();
+    if (state) {
+      layout_ = state->GetPangoLayoutCache()->Get(text, font->GetNative(),
+                                                  width);
+      // Apply the font options and transformation of |context|, the layout
+      // is only shaped again when they differ from last time.
+      pango_cairo_update_layout(context, layout_);
+      return;
+    }
+    layout_ = pango_cairo_create_layout(context);
+    owned_ = true;
+    pango_layout_set_font_description(layout_, font->GetNative());
+    pango_layout_set_text(layout_, text.data(), text.length());
+    if (width >= 0)
+      pango_layout_set_width(layout_, width * PANGO_SCALE);
+  }
+
+  ~ScopedTextLayout() {
+    if (owned_)
+      g_object_unref(layout_);
+  }
+
+  PangoLayout* get() const { return layout_; }
+
+ private:
+  PangoLayout* layout_;
+  bool owned_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedTextLayout);
+};
+
+}  // namespace
+
 PainterGtk::PainterGtk(cairo_t* context)
     : context_(context),
       is_context_managed_(false) {
@@ -87,6 +171,12 @@ void PainterGtk::ClipRect(const RectF& rect) {
   cairo_clip(context_);
 }
 
+bool PainterGtk::QuickReject(const RectF& rect) {
+  double x1, y1, x2, y2;
+  cairo_clip_extents(context_, &x1, &y1, &x2, &y2);
+  return !RectF(x1, y1, x2 - x1, y2 - y1).Intersects(rect);
+}
+
 void PainterGtk::Translate(const Vector2dF& offset) {
   cairo_translate(context_, offset.x(), offset.y());
 }
@@ -126,6 +216,26 @@ void PainterGtk::Fill() {
   cairo_fill(context_);
 }
 
+void PainterGtk::StrokePath(Path* path) {
+  cairo_new_path(context_);
+  cairo_append_path(context_, path->GetNative());
+  SetSourceColor(true);
+  cairo_stroke(context_);
+}
+
+void PainterGtk::FillPath(Path* path) {
+  cairo_new_path(context_);
+  cairo_append_path(context_, path->GetNative());
+  SetSourceColor(false);
+  cairo_fill(context_);
+}
+
+void PainterGtk::ClipPath(Path* path) {
+  cairo_new_path(context_);
+  cairo_append_path(context_, path->GetNative());
+  cairo_clip(context_);
+}
+
 void PainterGtk::StrokeRect(const RectF& rect) {
   cairo_new_path(context_);
   cairo_rectangle(context_, rect.x(), rect.y(), rect.width(), rect.height());
@@ -153,14 +263,43 @@ void PainterGtk::DrawImageFromRect(Image* image, const RectF& src,
   cairo_new_path(context_);
   cairo_rectangle(context_, 0, 0, dest.width(), dest.height());
   cairo_clip(context_);
+  // When drawing the whole image resized, use a resized copy so the image is
+  // not scaled for every draw.
+  SizeF device_size = GetDevicePixelSize(context_, dest.size());
+  Size pixel_size(static_cast<int>(round(device_size.width())),
+                  static_cast<int>(round(device_size.height())));
+  SizeF scaled_size(pixel_size.width(), pixel_size.height());
+  SizeF image_size = ScaleSize(image->GetSize(), image->GetScaleFactor());
+  bool use_scaled = ps == RectF(image_size) &&
+                    scaled_size != image_size &&
+                    !pixel_size.IsEmpty() &&
+                    IsAxisAligned(context_);
+  cairo_surface_t* surface;
+  if (use_scaled) {
+    surface = image->GetScaledCairoSurface(pixel_size);
+    ps = RectF(scaled_size);
+  } else if (image->IsMipmapped() && !ps.IsEmpty()) {
+    // Pick the mipmap level that is closest to the drawn size of the image.
+    float x_ratio = device_size.width() / ps.width();
+    float y_ratio = device_size.height() / ps.height();
+    surface = image->GetMipmapCairoSurface(
+        Size(static_cast<int>(ceil(image_size.width() * x_ratio)),
+             static_cast<int>(ceil(image_size.height() * y_ratio))));
+    ps = ScaleRect(ps,
+                   cairo_image_surface_get_width(surface) / image_size.width(),
+                   cairo_image_surface_get_height(surface) /
+                       image_size.height());
+  } else {
+    surface = image->GetCairoSurface();
+  }
   // Scale if needed.
-  SizeF size = image->GetSize();
   float x_scale = dest.width() / ps.width();
   float y_scale = dest.height() / ps.height();
   if (x_scale != 1.0f || y_scale != 1.0f)
     cairo_scale(context_, x_scale, y_scale);
   // Draw.
-  gdk_cairo_set_source_pixbuf(context_, image->GetNative(), -ps.x(), -ps.y());
+  cairo_set_source_surface(context_, surface, -ps.x(), -ps.y());
+  cairo_surface_destroy(surface);
   cairo_paint(context_);
   cairo_restore(context_);
 }
@@ -170,7 +309,8 @@ void PainterGtk::DrawCanvas(Canvas* canvas, const RectF& rect) {
 }
 
 void PainterGtk::DrawCanvasFromRect(Canvas* canvas, const RectF& src,
-                                    const RectF& dest) {
+                                    const RectF& rect) {
+  RectF dest = SnapToDevicePixels(context_, rect);
   cairo_save(context_);
   // Clip the image to |dest|.
   cairo_translate(context_, dest.x(), dest.y());
@@ -191,55 +331,46 @@ void PainterGtk::DrawCanvasFromRect(Canvas* canvas, const RectF& src,
 
 TextMetrics PainterGtk::MeasureText(const std::string& text, float width,
                                     const TextAttributes& attributes) {
-  PangoLayout* layout = pango_cairo_create_layout(context_);
-  pango_layout_set_font_description(layout, attributes.font->GetNative());
-  pango_layout_set_text(layout, text.data(), text.length());
-  if (width >= 0)
-    pango_layout_set_width(layout, width * PANGO_SCALE);
+  ScopedTextLayout layout(context_, text, attributes.font.get(), width);
   int bwidth, bheight;
-  pango_layout_get_pixel_size(layout, &bwidth, &bheight);
-  g_object_unref(layout);
+  pango_layout_get_pixel_size(layout.get(), &bwidth, &bheight);
   return { SizeF(bwidth, bheight) };
 }
 
 void PainterGtk::DrawText(const std::string& text, const RectF& rect,
                           const TextAttributes& attributes) {
-  PangoLayout* layout = pango_cairo_create_layout(context_);
-  pango_layout_set_font_description(layout, attributes.font->GetNative());
-  cairo_save(context_);
-
   // Text size.
+  ScopedTextLayout layout(context_, text, attributes.font.get(),
+                          rect.width());
   int width, height;
-  pango_layout_set_width(layout, rect.width() * PANGO_SCALE);
-  pango_layout_set_text(layout, text.data(), text.length());
-  pango_layout_get_pixel_size(layout, &width, &height);
+  pango_layout_get_pixel_size(layout.get(), &width, &height);
 
   // Horizontal alignment.
-  RectF bounds(rect);
+  PointF origin(rect.origin());
   if (attributes.align == TextAlign::Center)
-    bounds.Inset((rect.width() - width) / 2.f, 0.f);
+    origin.Offset((rect.width() - width) / 2.f, 0.f);
   else if (attributes.align == TextAlign::End)
-    bounds.Inset(rect.width() - width, 0.f, 0.f, 0.f);
+    origin.Offset(rect.width() - width, 0.f);
 
   // Vertical alignment
   if (attributes.valign == TextAlign::Center)
-    bounds.Inset(0.f, (rect.height() - height) / 2);
+    origin.Offset(0.f, (rect.height() - height) / 2.f);
   else if (attributes.valign == TextAlign::End)
-    bounds.Inset(0.f, rect.height() - height, 0.f, 0.f);
+    origin.Offset(0.f, rect.height() - height);
+
+  cairo_save(context_);
 
   // Apply the color.
   Color color = attributes.color;
   cairo_set_source_rgba(context_, color.r() / 255., color.g() / 255.,
                                   color.b() / 255., color.a() / 255.);
 
-  // Draw text.
-  cairo_move_to(context_, bounds.x(), bounds.y());
-  pango_layout_set_width(layout, bounds.width() * PANGO_SCALE);
-  pango_layout_set_height(layout, bounds.height() * PANGO_SCALE);
-  pango_cairo_show_layout(context_, layout);
+  // Draw text, the layout is already shaped in the width of |rect| and is drawn
+  // as it is.
+  cairo_move_to(context_, origin.x(), origin.y());
+  pango_cairo_show_layout(context_, layout.get());
 
   cairo_restore(context_);
-  g_object_unref(layout);
 }
 
 void PainterGtk::Initialize() {
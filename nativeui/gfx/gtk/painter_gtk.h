@@ -35,6 +35,7 @@ class PainterGtk : public Painter {
   void Rect(const RectF& rect) override;
   void Clip() override;
   void ClipRect(const RectF& rect) override;
+  bool QuickReject(const RectF& rect) override;
   void Translate(const Vector2dF& offset) override;
   void Rotate(float angle) override;
   void Scale(const Vector2dF& scale) override;
@@ -44,6 +45,9 @@ class PainterGtk : public Painter {
   void SetLineWidth(float width) override;
   void Stroke() override;
   void Fill() override;
+  void StrokePath(Path* path) override;
+  void FillPath(Path* path) override;
+  void ClipPath(Path* path) override;
   void StrokeRect(const RectF& rect) override;
   void FillRect(const RectF& rect) override;
   void DrawImage(Image* image, const RectF& rect) override;
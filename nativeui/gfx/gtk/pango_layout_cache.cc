@@ -0,0 +1,85 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/gtk/pango_layout_cache.h"
+
+#include <pango/pangocairo.h>
+
+#include <functional>
+
+namespace nu {
+
+// static
+const size_t PangoLayoutCache::kDefaultCapacity;
+
+// Fonts are compared by their descriptions, since the same font can be created
+// more than once.
+bool PangoLayoutCache::Key::operator==(const Key& other) const {
+  return width == other.width && text == other.text &&
+         pango_font_description_equal(font, other.font);
+}
+
+size_t PangoLayoutCache::KeyHash::operator()(const Key& key) const {
+  size_t hash = std::hash<std::string>()(key.text);
+  hash = hash * 31 + pango_font_description_hash(key.font);
+  return hash * 31 + key.width;
+}
+
+void PangoLayoutCache::LayoutDeleter::operator()(PangoLayout* layout) const {
+  g_object_unref(layout);
+}
+
+PangoLayoutCache::PangoLayoutCache(size_t capacity) : layouts_(capacity) {
+}
+
+PangoLayoutCache::~PangoLayoutCache() {
+  layouts_.Clear();
+  if (context_)
+    g_object_unref(context_);
+}
+
+PangoLayout* PangoLayoutCache::Get(const std::string& text,
+                                   const PangoFontDescription* font,
+                                   float width) {
+  Key key = { text, font,
+              width < 0 ? -1 : static_cast<int>(width * PANGO_SCALE) };
+  auto it = layouts_.Get(key);
+  if (it != layouts_.end()) {
+    ++hits_;
+    return it->second.get();
+  }
+
+  ++misses_;
+  PangoLayout* layout = pango_layout_new(GetContext());
+  pango_layout_set_font_description(layout, font);
+  pango_layout_set_text(layout, text.data(), text.length());
+  if (width >= 0)
+    pango_layout_set_width(layout, key.width);
+  // The caller's description may be freed before the layout.
+  key.font = pango_layout_get_font_description(layout);
+  layouts_.Put(key, std::unique_ptr<PangoLayout, LayoutDeleter>(layout));
+  return layout;
+}
+
+void PangoLayoutCache::Clear() {
+  layouts_.Clear();
+}
+
+void PangoLayoutCache::ResetCounters() {
+  hits_ = 0;
+  misses_ = 0;
+}
+
+PangoContext* PangoLayoutCache::GetContext() {
+  // The layouts are not bound to any cairo context, so they can be drawn on
+  // all painters after updating them with pango_cairo_update_layout. This is
+  // the same context pango_cairo_create_layout creates before applying the
+  // transformation of the cairo context.
+  if (!context_)
+    context_ = pango_font_map_create_context(
+        pango_cairo_font_map_get_default());
+  return context_;
+}
+
+}  // namespace nu
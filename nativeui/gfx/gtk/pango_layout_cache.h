@@ -0,0 +1,81 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_GFX_GTK_PANGO_LAYOUT_CACHE_H_
+#define NATIVEUI_GFX_GTK_PANGO_LAYOUT_CACHE_H_
+
+#include <pango/pango.h>
+
+#include <memory>
+#include <string>
+
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+
+namespace nu {
+
+// Keeps the recently shaped PangoLayouts, so measuring and drawing the same
+// text does not shape it again.
+class PangoLayoutCache {
+ public:
+  // The default number of layouts remembered.
+  static const size_t kDefaultCapacity = 128;
+
+  explicit PangoLayoutCache(size_t capacity = kDefaultCapacity);
+  ~PangoLayoutCache();
+
+  // Return the layout of |text| shaped with |font| in |width|, a negative
+  // |width| means no constraint. The layout is owned by the cache and is only
+  // valid until next call, it must not be modified except for updating it
+  // with pango_cairo_update_layout before drawing.
+  PangoLayout* Get(const std::string& text, const PangoFontDescription* font,
+                   float width);
+
+  // Forget all layouts.
+  void Clear();
+
+  // Counters for tuning the capacity.
+  size_t hits() const { return hits_; }
+  size_t misses() const { return misses_; }
+  void ResetCounters();
+
+  // Return the number of cached layouts.
+  size_t size() const { return layouts_.size(); }
+
+ private:
+  struct LayoutDeleter {
+    void operator()(PangoLayout* layout) const;
+  };
+
+  // The text, the font description and the width in pango units.
+  struct Key {
+    bool operator==(const Key& other) const;
+
+    std::string text;
+    // Owned by the cached layout, or by the caller when looking up.
+    const PangoFontDescription* font;
+    int width;
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  using Layouts = base::HashingMRUCache<
+      Key, std::unique_ptr<PangoLayout, LayoutDeleter>, KeyHash>;
+
+  PangoContext* GetContext();
+
+  Layouts layouts_;
+  PangoContext* context_ = nullptr;
+
+  size_t hits_ = 0;
+  size_t misses_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(PangoLayoutCache);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_GFX_GTK_PANGO_LAYOUT_CACHE_H_
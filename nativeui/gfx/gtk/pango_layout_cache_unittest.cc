@@ -0,0 +1,71 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/gtk/pango_layout_cache.h"
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class PangoLayoutCacheTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    cache_ = state_.GetPangoLayoutCache();
+    cache_->Clear();
+    cache_->ResetCounters();
+    attributes_.font = nu::App::GetCurrent()->GetDefaultFont();
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  nu::PangoLayoutCache* cache_;
+  nu::TextAttributes attributes_;
+};
+
+TEST_F(PangoLayoutCacheTest, SharedByMeasureAndDraw) {
+  scoped_refptr<nu::Canvas> canvas(new nu::Canvas(nu::SizeF(100, 100)));
+  nu::Painter* painter = canvas->GetPainter();
+  nu::TextMetrics metrics = painter->MeasureText("text", 100, attributes_);
+  EXPECT_EQ(cache_->misses(), 1u);
+  EXPECT_EQ(cache_->hits(), 0u);
+  painter->DrawText("text", nu::RectF(0, 0, 100, 100), attributes_);
+  EXPECT_EQ(cache_->misses(), 1u);
+  EXPECT_EQ(cache_->hits(), 1u);
+  EXPECT_EQ(painter->MeasureText("text", 100, attributes_).size, metrics.size);
+  EXPECT_EQ(cache_->hits(), 2u);
+  EXPECT_EQ(cache_->size(), 1u);
+}
+
+TEST_F(PangoLayoutCacheTest, DifferentWidth) {
+  scoped_refptr<nu::Canvas> canvas(new nu::Canvas(nu::SizeF(100, 100)));
+  nu::Painter* painter = canvas->GetPainter();
+  painter->MeasureText("text", -1, attributes_);
+  painter->MeasureText("text", -2, attributes_);
+  EXPECT_EQ(cache_->size(), 1u);
+  painter->MeasureText("text", 50, attributes_);
+  EXPECT_EQ(cache_->size(), 2u);
+  EXPECT_EQ(cache_->misses(), 2u);
+}
+
+TEST_F(PangoLayoutCacheTest, Eviction) {
+  nu::PangoLayoutCache cache(2);
+  PangoFontDescription* font = attributes_.font->GetNative();
+  cache.Get("a", font, -1);
+  cache.Get("b", font, -1);
+  cache.Get("a", font, -1);
+  cache.Get("c", font, -1);
+  EXPECT_EQ(cache.size(), 2u);
+  cache.Get("a", font, -1);
+  EXPECT_EQ(cache.hits(), 2u);
+  cache.Get("b", font, -1);
+  EXPECT_EQ(cache.misses(), 4u);
+}
+
+TEST_F(PangoLayoutCacheTest, SameFontDescription) {
+  PangoFontDescription* font =
+      pango_font_description_copy(attributes_.font->GetNative());
+  cache_->Get("text", font, -1);
+  pango_font_description_free(font);
+  cache_->Get("text", attributes_.font->GetNative(), -1);
+  EXPECT_EQ(cache_->hits(), 1u);
+  EXPECT_EQ(cache_->size(), 1u);
+}
@@ -0,0 +1,94 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/path.h"
+
+#include <cairo.h>
+
+namespace nu {
+
+namespace {
+
+// Paths do not need a real target to be built on.
+cairo_t* CreatePathContext() {
+  cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_A8, 0, 0);
+  cairo_t* context = cairo_create(surface);
+  cairo_surface_destroy(surface);
+  return context;
+}
+
+}  // namespace
+
+Path::Path() : context_(CreatePathContext()) {
+}
+
+Path::~Path() {
+  DiscardCopy();
+  cairo_destroy(context_);
+}
+
+void Path::MoveTo(const PointF& p) {
+  DiscardCopy();
+  cairo_move_to(context_, p.x(), p.y());
+}
+
+void Path::LineTo(const PointF& p) {
+  DiscardCopy();
+  cairo_line_to(context_, p.x(), p.y());
+}
+
+void Path::BezierCurveTo(const PointF& cp1,
+                         const PointF& cp2,
+                         const PointF& ep) {
+  DiscardCopy();
+  cairo_curve_to(
+      context_, cp1.x(), cp1.y(), cp2.x(), cp2.y(), ep.x(), ep.y());
+}
+
+void Path::Arc(const PointF& point, float radius, float sa, float ea) {
+  DiscardCopy();
+  cairo_arc(context_, point.x(), point.y(), radius, sa, ea);
+}
+
+void Path::Rect(const RectF& rect) {
+  DiscardCopy();
+  cairo_rectangle(context_, rect.x(), rect.y(), rect.width(), rect.height());
+}
+
+void Path::ClosePath() {
+  DiscardCopy();
+  cairo_close_path(context_);
+}
+
+void Path::Clear() {
+  DiscardCopy();
+  cairo_new_path(context_);
+}
+
+scoped_refptr<Path> Path::Clone() const {
+  scoped_refptr<Path> path(new Path);
+  cairo_append_path(path->context_, GetNative());
+  return path;
+}
+
+RectF Path::GetBounds() const {
+  double x1, y1, x2, y2;
+  cairo_path_extents(context_, &x1, &y1, &x2, &y2);
+  return RectF(x1, y1, x2 - x1, y2 - y1);
+}
+
+NativePath Path::GetNative() const {
+  if (!path_)
+    path_ = cairo_copy_path(context_);
+  return path_;
+}
+
+void Path::DiscardCopy() {
+  if (path_) {
+    cairo_path_destroy(path_);
+    path_ = nullptr;
+  }
+}
+
+}  // namespace nu
@@ -4,9 +4,20 @@
 
 #include "nativeui/gfx/image.h"
 
+#include <algorithm>
+
+#include "base/base64.h"
+#include "base/bind.h"
 #include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/memory_mapped_file.h"
 #include "base/strings/pattern.h"
 #include "base/strings/string_util.h"
+#include "base/threading/thread.h"
+#include "nativeui/gfx/geometry/safe_integer_conversions.h"
+#include "nativeui/gfx/geometry/size_conversions.h"
+#include "nativeui/lifetime.h"
+#include "nativeui/state.h"
 
 namespace nu {
 
@@ -32,8 +43,146 @@ ScaleFactorPair kScaleFactorPairs[] = {
   { FILE_PATH_LITERAL("@2.5x")  , 2.5f },
 };
 
+// Run |task| after current call returns, or run it now when there is no
+// message loop to post to.
+void PostReply(const Lifetime::Task& task) {
+  Lifetime* lifetime = Lifetime::GetCurrent();
+  if (lifetime)
+    lifetime->PostTask(task);
+  else
+    task();
+}
+
 }  // namespace
 
+Image::Image(NativeImage image, float scale_factor)
+    : scale_factor_(scale_factor), image_(image) {
+}
+
+// static
+Image* Image::CreateFromBuffer(const void* data, size_t size,
+                               float scale_factor) {
+  if (size == 0)
+    return nullptr;
+  NativeImage image = PlatformDecodeBuffer(data, size, scale_factor);
+  if (!image)
+    return nullptr;
+  return new Image(image, scale_factor);
+}
+
+// static
+Image* Image::CreateFromBase64(const std::string& data, float scale_factor) {
+  base::StringPiece encoded(data);
+  if (base::StartsWith(encoded, "data:",
+                       base::CompareCase::INSENSITIVE_ASCII)) {
+    size_t comma = encoded.find(',');
+    if (comma == base::StringPiece::npos ||
+        !base::EndsWith(encoded.substr(0, comma), ";base64",
+                        base::CompareCase::INSENSITIVE_ASCII))
+      return nullptr;
+    encoded = encoded.substr(comma + 1);
+  }
+  std::string decoded;
+  if (!base::Base64Decode(encoded, &decoded))
+    return nullptr;
+  return CreateFromBuffer(decoded.data(), decoded.size(), scale_factor);
+}
+
+// static
+Image* Image::CreateFromMappedFile(const base::FilePath& path) {
+  base::MemoryMappedFile file;
+  if (!file.Initialize(path))
+    return nullptr;
+  return CreateFromBuffer(file.data(), file.length(),
+                          GetScaleFactorFromFilePath(path));
+}
+
+// static
+Image* Image::CreateFromPathAtSize(const base::FilePath& path,
+                                   const SizeF& size,
+                                   float scale_factor) {
+  Size pixel_size = ToFlooredSize(ScaleSize(size, scale_factor));
+  if (pixel_size.IsEmpty())
+    return nullptr;
+  NativeImage image = PlatformDecodeFileAtSize(path, pixel_size, scale_factor);
+  if (!image)
+    return nullptr;
+  return new Image(image, scale_factor);
+}
+
+// static
+void Image::CreateFromPathAsync(const base::FilePath& path,
+                                const DecodeCallback& callback) {
+  base::File::Info info;
+  if (!base::GetFileInfo(path, &info) || info.is_directory) {
+    PostReply([callback]() { callback(nullptr); });
+    return;
+  }
+
+  base::Time mtime = info.last_modified;
+  State* state = State::GetCurrent();
+  ImageCache* cache = state->image_cache();
+  scoped_refptr<Image> cached = cache->Get(path, mtime);
+  if (cached) {
+    PostReply([callback, cached]() { callback(cached.get()); });
+    return;
+  }
+
+  // Requests of the image being decoded wait for the same result.
+  if (!cache->AddRequest(path, mtime, callback))
+    return;
+
+  Lifetime* lifetime = Lifetime::GetCurrent();
+  if (Lifetime::kThreadSafePostTask && lifetime) {
+    state->GetWorkerThread()->task_runner()->PostTask(
+        FROM_HERE, base::Bind(&Image::DecodeOnWorker, path, mtime, lifetime));
+  } else {
+    PostReply([path, mtime]() {
+      float scale_factor = 1.f;
+      NativeImage image = PlatformDecodeFile(path, &scale_factor);
+      FinishDecode(path, mtime, image, scale_factor);
+    });
+  }
+}
+
+// static
+void Image::DecodeOnWorker(const base::FilePath& path, base::Time mtime,
+                           Lifetime* lifetime) {
+  float scale_factor = 1.f;
+  NativeImage image = PlatformDecodeFile(path, &scale_factor);
+  // The Lifetime outlives the worker threads.
+  lifetime->PostTask([path, mtime, image, scale_factor]() {
+    FinishDecode(path, mtime, image, scale_factor);
+  });
+}
+
+// static
+void Image::FinishDecode(const base::FilePath& path, base::Time mtime,
+                         NativeImage image, float scale_factor) {
+  scoped_refptr<Image> result;
+  if (image)
+    result = new Image(image, scale_factor);
+  // The State may be gone before the result arrives.
+  State* state = State::GetCurrent();
+  if (!state)
+    return;
+  ImageCache* cache = state->image_cache();
+  if (result)
+    cache->Put(path, mtime, result.get());
+  for (const DecodeCallback& callback : cache->TakeRequests(path, mtime))
+    callback(result.get());
+}
+
+// static
+Size Image::GetFitSize(const Size& size, const Size& bounds) {
+  if (size.width() <= bounds.width() && size.height() <= bounds.height())
+    return size;
+  float scale = std::min(static_cast<float>(bounds.width()) / size.width(),
+                         static_cast<float>(bounds.height()) / size.height());
+  return Size(std::max(1, ToRoundedInt(size.width() * scale)),
+              std::max(1, ToRoundedInt(size.height() * scale)));
+}
+
 // static
 float Image::GetScaleFactorFromFilePath(const base::FilePath& path) {
   base::FilePath::StringType name(path.BaseName().RemoveExtension().value());
@@ -5,38 +5,154 @@
 #ifndef NATIVEUI_GFX_IMAGE_H_
 #define NATIVEUI_GFX_IMAGE_H_
 
+#include <functional>
+#include <string>
+#include <vector>
+
 #include "base/files/file_path.h"
 #include "base/memory/ref_counted.h"
+#include "base/synchronization/lock.h"
+#include "nativeui/gfx/geometry/size.h"
 #include "nativeui/gfx/geometry/size_f.h"
 #include "nativeui/types.h"
 
+namespace base {
+class Time;
+}
+
 namespace nu {
 
+class Lifetime;
+
 class NATIVEUI_EXPORT Image : public base::RefCounted<Image> {
  public:
   // Create an image by reading from |path|.
   // The @2x suffix in basename will make the image have scale factor.
   explicit Image(const base::FilePath& path);
 
+  // Create an image by decoding |size| bytes of |data|, which can be in any
+  // format the platform reads. Return nullptr if decoding failed.
+  static Image* CreateFromBuffer(const void* data, size_t size,
+                                 float scale_factor);
+
+  // Create an image from base64 encoded |data|, which can also be a data URI
+  // like "data:image/png;base64,...". Return nullptr if decoding failed.
+  static Image* CreateFromBase64(const std::string& data, float scale_factor);
+
+  // Create an image by mapping the file at |path| into memory instead of
+  // reading it, which saves a copy for large files. Return nullptr if the file
+  // can not be read.
+  static Image* CreateFromMappedFile(const base::FilePath& path);
+
+  // Create an image by reading from |path| and decoding it directly to fit in
+  // |size| at |scale_factor|, keeping the aspect ratio. Images smaller than
+  // |size| are not enlarged. Return nullptr if the file can not be read.
+  //
+  // This is much cheaper than reading the full image for thumbnails.
+  static Image* CreateFromPathAtSize(const base::FilePath& path,
+                                     const SizeF& size,
+                                     float scale_factor);
+
+  // Decode the image at |path| on a worker thread, and pass it to |callback|
+  // on current thread. The decoded images are cached by their paths and
+  // modification times, the |callback| receives nullptr if decoding failed.
+  using DecodeCallback = std::function<void(Image*)>;
+  static void CreateFromPathAsync(const base::FilePath& path,
+                                  const DecodeCallback& callback);
+
   // Get the size of image.
   SizeF GetSize() const;
 
   // Get the scale factor of image.
   float GetScaleFactor() const { return scale_factor_; }
 
+  // Whether to keep a chain of downscaled copies, which is used when the image
+  // is drawn at a much smaller size.
+  void SetMipmapped(bool mipmapped);
+  bool IsMipmapped() const { return mipmapped_; }
+
   // Return the native instance of image object.
   NativeImage GetNative() const;
 
+#if defined(OS_LINUX)
+  // The surfaces below can be got on any thread, since painters of PaintAsync
+  // draw images on worker threads. The returned surface holds a reference
+  // that must be released with cairo_surface_destroy.
+
+  // Internal: Return the image as a premultiplied cairo surface, which is
+  // converted from the pixbuf on first use.
+  cairo_surface_t* GetCairoSurface();
+
+  // Internal: Return the image resized to |size| in pixels, the recently used
+  // sizes are cached.
+  cairo_surface_t* GetScaledCairoSurface(const Size& size);
+
+  // Internal: Return the smallest level of the mipmaps that is not smaller
+  // than |size| in pixels, the levels are created on first use.
+  cairo_surface_t* GetMipmapCairoSurface(const Size& size);
+#endif
+
  protected:
   virtual ~Image();
 
  private:
   friend class base::RefCounted<Image>;
 
+  // Take the ownership of |image|.
+  Image(NativeImage image, float scale_factor);
+
+  static void DecodeOnWorker(const base::FilePath& path, base::Time mtime,
+                             Lifetime* lifetime);
+  static void FinishDecode(const base::FilePath& path, base::Time mtime,
+                           NativeImage image, float scale_factor);
+
   static float GetScaleFactorFromFilePath(const base::FilePath& path);
 
+#if defined(OS_LINUX)
+  // Same with the public ones but without adding reference, must be called
+  // with |lock_| acquired.
+  cairo_surface_t* GetCairoSurfaceLocked();
+  cairo_surface_t* GetMipmapCairoSurfaceLocked(const Size& size);
+#endif
+
+  // Return the size that |size| is scaled to for fitting in |bounds|.
+  static Size GetFitSize(const Size& size, const Size& bounds);
+
+  // Decode the image in |data|, return nullptr on failure. The |data| is not
+  // used after returning.
+  static NativeImage PlatformDecodeBuffer(const void* data, size_t size,
+                                          float scale_factor);
+
+  // Read the image at |path|, return nullptr on failure. This can be called on
+  // any thread.
+  static NativeImage PlatformDecodeFile(const base::FilePath& path,
+                                        float* scale_factor);
+
+  // Read the image at |path| and decode it to fit in |size| in pixels.
+  static NativeImage PlatformDecodeFileAtSize(const base::FilePath& path,
+                                              const Size& size,
+                                              float scale_factor);
+
   float scale_factor_;
   NativeImage image_;
+  bool mipmapped_ = false;
+
+#if defined(OS_LINUX)
+  // Guards the cached surfaces.
+  base::Lock lock_;
+
+  cairo_surface_t* surface_ = nullptr;
+
+  // The resized surfaces, most recently used first.
+  struct ScaledSurface {
+    Size size;
+    cairo_surface_t* surface;
+  };
+  std::vector<ScaledSurface> scaled_surfaces_;
+
+  // Each level is half the size of previous one, starting from |surface_|.
+  std::vector<cairo_surface_t*> mipmaps_;
+#endif
 };
 
 }  // namespace nu
@@ -0,0 +1,170 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <string>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+// A 2x2 24bit BMP, which can be read on all platforms.
+const unsigned char kBitmap[] = {
+  'B', 'M', 70, 0, 0, 0, 0, 0, 0, 0, 54, 0, 0, 0,
+  40, 0, 0, 0, 2, 0, 0, 0, 2, 0, 0, 0, 1, 0, 24, 0,
+  0, 0, 0, 0, 16, 0, 0, 0, 0x13, 0x0B, 0, 0, 0x13, 0x0B, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 255, 0, 255, 0, 0, 0,
+  255, 0, 0, 255, 255, 255, 0, 0,
+};
+
+const char kBitmapDataURI[] =
+    "data:image/bmp;base64,"
+    "Qk1GAAAAAAAAADYAAAAoAAAAAgAAAAIAAAABABgAAAAAABAAAAATCwAAEwsAAAAA"
+    "AAAAAAAAAAD/AP8AAAD/AAD///8AAA==";
+
+}  // namespace
+
+class ImageTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    path_ = temp_dir_.GetPath().Append(FILE_PATH_LITERAL("image.bmp"));
+    ASSERT_EQ(base::WriteFile(path_, reinterpret_cast<const char*>(kBitmap),
+                              sizeof(kBitmap)),
+              static_cast<int>(sizeof(kBitmap)));
+  }
+
+  base::ScopedTempDir temp_dir_;
+  base::FilePath path_;
+  nu::Lifetime lifetime_;
+  nu::State state_;
+};
+
+TEST_F(ImageTest, CreateFromPathAsync) {
+  scoped_refptr<nu::Image> image;
+  nu::Image::CreateFromPathAsync(path_, [&](nu::Image* result) {
+    image = result;
+    lifetime_.Quit();
+  });
+  EXPECT_EQ(image.get(), nullptr);
+  lifetime_.Run();
+  ASSERT_NE(image.get(), nullptr);
+  EXPECT_EQ(image->GetSize(), nu::SizeF(2, 2));
+
+  // Decoded images are cached.
+  scoped_refptr<nu::Image> cached;
+  nu::Image::CreateFromPathAsync(path_, [&](nu::Image* result) {
+    cached = result;
+    lifetime_.Quit();
+  });
+  lifetime_.Run();
+  EXPECT_EQ(cached, image);
+}
+
+TEST_F(ImageTest, CreateFromPathAsyncShareRequests) {
+  int count = 0;
+  scoped_refptr<nu::Image> images[2];
+  for (int i = 0; i < 2; ++i) {
+    nu::Image::CreateFromPathAsync(path_, [&, i](nu::Image* result) {
+      images[i] = result;
+      if (++count == 2)
+        lifetime_.Quit();
+    });
+  }
+  lifetime_.Run();
+  ASSERT_NE(images[0].get(), nullptr);
+  EXPECT_EQ(images[0], images[1]);
+  EXPECT_EQ(state_.image_cache()->size(), 1u);
+}
+
+TEST_F(ImageTest, CreateFromPathAsyncFailure) {
+  bool called = false;
+  nu::Image::CreateFromPathAsync(
+      temp_dir_.GetPath().Append(FILE_PATH_LITERAL("nonexistent.png")),
+      [&](nu::Image* result) {
+        called = true;
+        EXPECT_EQ(result, nullptr);
+        lifetime_.Quit();
+      });
+  lifetime_.Run();
+  EXPECT_TRUE(called);
+  EXPECT_EQ(state_.image_cache()->size(), 0u);
+}
+
+TEST_F(ImageTest, CreateFromBuffer) {
+  scoped_refptr<nu::Image> image =
+      nu::Image::CreateFromBuffer(kBitmap, sizeof(kBitmap), 2.f);
+  ASSERT_NE(image.get(), nullptr);
+  EXPECT_EQ(image->GetScaleFactor(), 2.f);
+  EXPECT_EQ(image->GetSize(), nu::SizeF(1, 1));
+
+  EXPECT_EQ(nu::Image::CreateFromBuffer("invalid", 7, 1.f), nullptr);
+  EXPECT_EQ(nu::Image::CreateFromBuffer(kBitmap, 0, 1.f), nullptr);
+}
+
+TEST_F(ImageTest, CreateFromBase64) {
+  scoped_refptr<nu::Image> image =
+      nu::Image::CreateFromBase64(kBitmapDataURI, 1.f);
+  ASSERT_NE(image.get(), nullptr);
+  EXPECT_EQ(image->GetSize(), nu::SizeF(2, 2));
+
+  // Plain base64 data.
+  std::string data(kBitmapDataURI);
+  image = nu::Image::CreateFromBase64(data.substr(data.find(',') + 1), 1.f);
+  ASSERT_NE(image.get(), nullptr);
+  EXPECT_EQ(image->GetSize(), nu::SizeF(2, 2));
+
+  EXPECT_EQ(nu::Image::CreateFromBase64("data:image/bmp,Qk1G", 1.f), nullptr);
+  EXPECT_EQ(nu::Image::CreateFromBase64("!!!", 1.f), nullptr);
+}
+
+TEST_F(ImageTest, CreateFromMappedFile) {
+  scoped_refptr<nu::Image> image = nu::Image::CreateFromMappedFile(path_);
+  ASSERT_NE(image.get(), nullptr);
+  EXPECT_EQ(image->GetSize(), nu::SizeF(2, 2));
+
+  EXPECT_EQ(nu::Image::CreateFromMappedFile(
+                temp_dir_.GetPath().Append(FILE_PATH_LITERAL("none.png"))),
+            nullptr);
+}
+
+TEST_F(ImageTest, CreateFromPathAtSize) {
+  scoped_refptr<nu::Image> image =
+      nu::Image::CreateFromPathAtSize(path_, nu::SizeF(1, 1), 1.f);
+  ASSERT_NE(image.get(), nullptr);
+  EXPECT_EQ(image->GetSize(), nu::SizeF(1, 1));
+
+  // Small images are not enlarged.
+  image = nu::Image::CreateFromPathAtSize(path_, nu::SizeF(10, 10), 2.f);
+  ASSERT_NE(image.get(), nullptr);
+  EXPECT_EQ(image->GetScaleFactor(), 2.f);
+  EXPECT_EQ(image->GetSize(), nu::SizeF(1, 1));
+}
+
+TEST_F(ImageTest, Mipmapped) {
+  scoped_refptr<nu::Image> image(new nu::Image(path_));
+  EXPECT_FALSE(image->IsMipmapped());
+  image->SetMipmapped(true);
+  EXPECT_TRUE(image->IsMipmapped());
+
+#if defined(OS_LINUX)
+  cairo_surface_t* level = image->GetMipmapCairoSurface(nu::Size(1, 1));
+  EXPECT_EQ(cairo_image_surface_get_width(level), 1);
+  cairo_surface_destroy(level);
+  cairo_surface_t* full = image->GetCairoSurface();
+  level = image->GetMipmapCairoSurface(nu::Size(2, 2));
+  EXPECT_EQ(level, full);
+  cairo_surface_destroy(level);
+  cairo_surface_destroy(full);
+#endif
+
+  scoped_refptr<nu::Canvas> canvas(new nu::Canvas(nu::SizeF(10, 10), 1.f));
+  canvas->GetPainter()->DrawImage(image.get(), nu::RectF(0, 0, 1, 1));
+  canvas->GetPainter()->Rotate(1.f);
+  canvas->GetPainter()->DrawImageFromRect(image.get(), nu::RectF(0, 0, 1, 1),
+                                          nu::RectF(0, 0, 0.5f, 0.5f));
+}
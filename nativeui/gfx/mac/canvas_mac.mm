@@ -27,6 +27,16 @@ NativeBitmap Canvas::PlatformCreateBitmap(const SizeF& size,
   return bitmap;
 }
 
+// static
+NativeBitmap Canvas::PlatformCreateBitmapFromPixels(const PixelBuffer& pixels,
+                                                    float scale_factor) {
+  base::ScopedCFTypeRef<CGColorSpaceRef> color_space(
+        CGColorSpaceCreateDeviceRGB());
+  return CGBitmapContextCreate(
+      pixels.data, pixels.width, pixels.height, 8, pixels.stride, color_space,
+      kCGBitmapByteOrder32Host | kCGImageAlphaPremultipliedFirst);
+}
+
 // static
 void Canvas::PlatformDestroyBitmap(NativeBitmap bitmap) {
   CGContextRelease(bitmap);
@@ -38,4 +48,18 @@ Painter* Canvas::PlatformCreatePainter(NativeBitmap bitmap,
   return new PainterMac(bitmap, scale_factor);
 }
 
+Canvas::PixelBuffer Canvas::PlatformLockPixels() {
+  CGContextFlush(bitmap_);
+  PixelBuffer pixels;
+  pixels.data = static_cast<uint8_t*>(CGBitmapContextGetData(bitmap_));
+  pixels.width = CGBitmapContextGetWidth(bitmap_);
+  pixels.height = CGBitmapContextGetHeight(bitmap_);
+  pixels.stride = CGBitmapContextGetBytesPerRow(bitmap_);
+  return pixels;
+}
+
+void Canvas::PlatformUnlockPixels(const Rect& dirty) {
+  // The bitmap context reads the memory directly.
+}
+
 }  // namespace nu
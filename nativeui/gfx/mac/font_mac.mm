@@ -134,4 +134,15 @@ NativeFont Font::GetNative() const {
   return font_;
 }
 
+FontMetrics Font::PlatformGetMetrics() const {
+  FontMetrics result;
+  result.ascent = [font_ ascender];
+  result.descent = -[font_ descender];
+  // The advance includes the side bearings, like the average widths reported
+  // by other platforms, while the bounding rect only covers the ink.
+  result.average_char_width =
+      [font_ advancementForGlyph:[font_ glyphWithName:@"x"]].width;
+  return result;
+}
+
 }  // namespace nu
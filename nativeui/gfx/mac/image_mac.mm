@@ -5,44 +5,126 @@
 #include "nativeui/gfx/image.h"
 
 #import <Cocoa/Cocoa.h>
+#import <ImageIO/ImageIO.h>
 
+#include <algorithm>
+
+#include "base/mac/foundation_util.h"
+#include "base/mac/scoped_cftyperef.h"
+#include "base/mac/scoped_nsautorelease_pool.h"
 #include "base/strings/sys_string_conversions.h"
 
 namespace nu {
 
 Image::Image(const base::FilePath& p)
     : scale_factor_(1.f),
-      image_([[NSImage alloc]
-                 initWithContentsOfFile:base::SysUTF8ToNSString(p.value())]) {
+      image_(PlatformDecodeFile(p, &scale_factor_)) {
+}
+
+Image::~Image() {
+  [image_ release];
+}
+
+SizeF Image::GetSize() const {
+  return SizeF([image_ size]);
+}
+
+void Image::SetMipmapped(bool mipmapped) {
+  // Cocoa picks the best representation of NSImage by itself.
+  mipmapped_ = mipmapped;
+}
+
+NativeImage Image::GetNative() const {
+  return image_;
+}
+
+// static
+NativeImage Image::PlatformDecodeBuffer(const void* data, size_t size,
+                                        float scale_factor) {
+  // NSImage keeps the data for decoding lazily, so it must own a copy.
+  NSImage* image = [[NSImage alloc]
+      initWithData:[NSData dataWithBytes:data length:size]];
+  NSArray* reps = [image representations];
+  if ([reps count] == 0) {
+    [image release];
+    return nil;
+  }
+  // The DPI of the image is ignored, like reading from files.
+  NSImageRep* rep = static_cast<NSImageRep*>([reps objectAtIndex:0]);
+  [image setSize:NSMakeSize([rep pixelsWide] / scale_factor,
+                            [rep pixelsHigh] / scale_factor)];
+  return image;
+}
+
+// static
+NativeImage Image::PlatformDecodeFile(const base::FilePath& p,
+                                      float* scale_factor) {
+  base::mac::ScopedNSAutoreleasePool pool;
+  NSImage* image = [[NSImage alloc]
+      initWithContentsOfFile:base::SysUTF8ToNSString(p.value())];
+  *scale_factor = 1.f;
   // Compute the scale factor from actual NSImageRep.
-  NSArray* reps = [image_ representations];
+  NSArray* reps = [image representations];
   if ([reps count] > 0) {
-    float lw = [image_ size].width;
+    float lw = [image size].width;
     float pw = [static_cast<NSImageRep*>([reps objectAtIndex:0]) pixelsWide];
     if (lw > 0 && pw > 0)
-      scale_factor_ = pw / lw;
+      *scale_factor = pw / lw;
     // NSImage caculates the DPI from the image automatically, which may not be
     // the same with the DPI set by the @2x suffix, in this case we need to set
     // size of NSImage to match the scale factor.
     float expected = GetScaleFactorFromFilePath(p);
-    if (scale_factor_ != expected) {
+    if (*scale_factor != expected) {
       float ph = [static_cast<NSImageRep*>([reps objectAtIndex:0]) pixelsHigh];
-      [image_ setSize:NSMakeSize(pw / expected, ph / expected)];
-      scale_factor_ = expected;
+      [image setSize:NSMakeSize(pw / expected, ph / expected)];
+      *scale_factor = expected;
     }
+    // NSImage decodes lazily when it is drawn, force decoding now so it does
+    // not happen on the main thread.
+    [image CGImageForProposedRect:nullptr context:nil hints:nil];
   }
+  return image;
 }
 
-Image::~Image() {
-  [image_ release];
-}
-
-SizeF Image::GetSize() const {
-  return SizeF([image_ size]);
-}
-
-NativeImage Image::GetNative() const {
-  return image_;
+// static
+NativeImage Image::PlatformDecodeFileAtSize(const base::FilePath& p,
+                                            const Size& size,
+                                            float scale_factor) {
+  base::mac::ScopedNSAutoreleasePool pool;
+  NSURL* url = [NSURL fileURLWithPath:base::SysUTF8ToNSString(p.value())];
+  base::ScopedCFTypeRef<CGImageSourceRef> source(
+      CGImageSourceCreateWithURL(base::mac::NSToCFCast(url), nullptr));
+  if (!source)
+    return nil;
+  // Only the header is read for getting the size.
+  base::ScopedCFTypeRef<CFDictionaryRef> properties(
+      CGImageSourceCopyPropertiesAtIndex(source, 0, nullptr));
+  if (!properties)
+    return nil;
+  NSDictionary* dict = base::mac::CFToNSCast(properties.get());
+  NSNumber* width = [dict objectForKey:base::mac::CFToNSCast(
+      kCGImagePropertyPixelWidth)];
+  NSNumber* height = [dict objectForKey:base::mac::CFToNSCast(
+      kCGImagePropertyPixelHeight)];
+  if (!width || !height)
+    return nil;
+  Size fit_size = GetFitSize(Size([width intValue], [height intValue]), size);
+  // ImageIO decodes the image at the scaled size directly.
+  NSDictionary* options = @{
+    base::mac::CFToNSCast(kCGImageSourceCreateThumbnailFromImageAlways): @YES,
+    base::mac::CFToNSCast(kCGImageSourceCreateThumbnailWithTransform): @YES,
+    base::mac::CFToNSCast(kCGImageSourceThumbnailMaxPixelSize):
+        @(std::max(fit_size.width(), fit_size.height())),
+  };
+  base::ScopedCFTypeRef<CGImageRef> image(
+      CGImageSourceCreateThumbnailAtIndex(
+          source, 0, base::mac::NSToCFCast(options)));
+  if (!image)
+    return nil;
+  return [[NSImage alloc]
+      initWithCGImage:image
+                 size:NSMakeSize(CGImageGetWidth(image) / scale_factor,
+                                 CGImageGetHeight(image) / scale_factor)];
 }
 
 }  // namespace nu
@@ -6,6 +6,8 @@
 
 #import <Cocoa/Cocoa.h>
 
+#include <cmath>
+
 #include "base/mac/scoped_cftyperef.h"
 #include "base/mac/scoped_nsobject.h"
 #include "base/strings/sys_string_conversions.h"
@@ -13,6 +15,7 @@
 #include "nativeui/gfx/font.h"
 #include "nativeui/gfx/image.h"
 #include "nativeui/gfx/mac/text_mac.h"
+#include "nativeui/gfx/path.h"
 
 namespace nu {
 
@@ -122,6 +125,10 @@ void PainterMac::ClipRect(const RectF& rect) {
   CGContextClipToRect(context_, rect.ToCGRect());
 }
 
+bool PainterMac::QuickReject(const RectF& rect) {
+  return !RectF(CGContextGetClipBoundingBox(context_)).Intersects(rect);
+}
+
 void PainterMac::Translate(const Vector2dF& offset) {
   CGContextTranslateCTM(context_, offset.x(), offset.y());
 }
@@ -161,6 +168,24 @@ void PainterMac::Fill() {
   CGContextFillPath(context_);
 }
 
+void PainterMac::StrokePath(Path* path) {
+  CGContextBeginPath(context_);
+  CGContextAddPath(context_, path->GetNative());
+  CGContextStrokePath(context_);
+}
+
+void PainterMac::FillPath(Path* path) {
+  CGContextBeginPath(context_);
+  CGContextAddPath(context_, path->GetNative());
+  CGContextFillPath(context_);
+}
+
+void PainterMac::ClipPath(Path* path) {
+  CGContextBeginPath(context_);
+  CGContextAddPath(context_, path->GetNative());
+  CGContextClip(context_);
+}
+
 void PainterMac::StrokeRect(const RectF& rect) {
   CGContextStrokeRect(context_, rect.ToCGRect());
 }
@@ -207,9 +232,20 @@ void PainterMac::DrawCanvas(Canvas* canvas, const RectF& rect) {
 
 void PainterMac::DrawCanvasFromRect(Canvas* canvas, const RectF& src,
                                     const RectF& dest) {
+  // Round the edges to device pixels so the bitmap is not resampled.
+  CGRect rect = dest.ToCGRect();
+  CGAffineTransform ctm = CGContextGetCTM(context_);
+  if (ctm.b == 0 && ctm.c == 0) {
+    CGRect device = CGContextConvertRectToDeviceSpace(context_, rect);
+    CGFloat x = std::round(CGRectGetMinX(device));
+    CGFloat y = std::round(CGRectGetMinY(device));
+    device = CGRectMake(x, y, std::round(CGRectGetMaxX(device)) - x,
+                        std::round(CGRectGetMaxY(device)) - y);
+    rect = CGContextConvertRectToUserSpace(context_, device);
+  }
   base::scoped_nsobject<NSImage> image(CreateNSImageFromCanvas(canvas));
   GraphicsContextScope scoped(target_context_);
-  [image drawInRect:dest.ToCGRect()
+  [image drawInRect:rect
            fromRect:src.ToCGRect()
           operation:NSCompositeSourceOver
            fraction:1.0
@@ -0,0 +1,75 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/path.h"
+
+#import <Cocoa/Cocoa.h>
+
+namespace nu {
+
+Path::Path() : path_(CGPathCreateMutable()) {
+}
+
+Path::~Path() {
+  CGPathRelease(path_);
+}
+
+void Path::MoveTo(const PointF& p) {
+  CGPathMoveToPoint(path_, nullptr, p.x(), p.y());
+}
+
+void Path::LineTo(const PointF& p) {
+  // Unlike CGContext, CGPath requires a current point.
+  if (CGPathIsEmpty(path_))
+    CGPathMoveToPoint(path_, nullptr, p.x(), p.y());
+  else
+    CGPathAddLineToPoint(path_, nullptr, p.x(), p.y());
+}
+
+void Path::BezierCurveTo(const PointF& cp1,
+                         const PointF& cp2,
+                         const PointF& ep) {
+  if (CGPathIsEmpty(path_))
+    CGPathMoveToPoint(path_, nullptr, cp1.x(), cp1.y());
+  CGPathAddCurveToPoint(
+      path_, nullptr, cp1.x(), cp1.y(), cp2.x(), cp2.y(), ep.x(), ep.y());
+}
+
+void Path::Arc(const PointF& point, float radius, float sa, float ea) {
+  // Painted in a flipped coordianate system, so use anti-clockwise.
+  CGPathAddArc(path_, nullptr, point.x(), point.y(), radius, sa, ea, false);
+}
+
+void Path::Rect(const RectF& rect) {
+  CGPathAddRect(path_, nullptr, rect.ToCGRect());
+}
+
+void Path::ClosePath() {
+  if (!CGPathIsEmpty(path_))
+    CGPathCloseSubpath(path_);
+}
+
+void Path::Clear() {
+  CGPathRelease(path_);
+  path_ = CGPathCreateMutable();
+}
+
+scoped_refptr<Path> Path::Clone() const {
+  scoped_refptr<Path> path(new Path);
+  CGPathRelease(path->path_);
+  path->path_ = CGPathCreateMutableCopy(path_);
+  return path;
+}
+
+RectF Path::GetBounds() const {
+  if (CGPathIsEmpty(path_))
+    return RectF();
+  return RectF(CGPathGetPathBoundingBox(path_));
+}
+
+NativePath Path::GetNative() const {
+  return path_;
+}
+
+}  // namespace nu
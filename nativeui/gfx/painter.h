@@ -21,6 +21,7 @@ namespace nu {
 
 class Canvas;
 class Image;
+class Path;
 
 // The interface for painting on canvas or window.
 class NATIVEUI_EXPORT Painter {
@@ -48,6 +49,10 @@ class NATIVEUI_EXPORT Painter {
   // Apply |rect| to the current clip using the specified region |op|.
   virtual void ClipRect(const RectF& rect) = 0;
 
+  // Return true if |rect| is completely outside the current clip area, so
+  // painting inside it can be skipped.
+  virtual bool QuickReject(const RectF& rect) = 0;
+
   // Transform operations.
   virtual void Translate(const Vector2dF& offset) = 0;
   virtual void Rotate(float angle) = 0;
@@ -67,6 +72,11 @@ class NATIVEUI_EXPORT Painter {
   // Draw a solid shape by filling current path's content area.
   virtual void Fill() = 0;
 
+  // Stroke, fill or clip with a prebuilt |path|, current path is cleared.
+  virtual void StrokePath(Path* path) = 0;
+  virtual void FillPath(Path* path) = 0;
+  virtual void ClipPath(Path* path) = 0;
+
   // Draw a single pixel |rect|.
   virtual void StrokeRect(const RectF& rect) = 0;
 
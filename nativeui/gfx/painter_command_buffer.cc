@@ -0,0 +1,232 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/painter_command_buffer.h"
+
+#include <cmath>
+
+#include "base/strings/stringprintf.h"
+#include "nativeui/gfx/color.h"
+#include "nativeui/gfx/painter.h"
+
+namespace nu {
+
+namespace {
+
+// Number of operands of each command.
+const size_t kOperandCounts[] = {
+  0,  // Save
+  0,  // Restore
+  0,  // BeginPath
+  0,  // ClosePath
+  2,  // MoveTo
+  2,  // LineTo
+  6,  // BezierCurveTo
+  5,  // Arc
+  4,  // Rect
+  0,  // Clip
+  4,  // ClipRect
+  2,  // Translate
+  1,  // Rotate
+  2,  // Scale
+  4,  // SetColor
+  4,  // SetStrokeColor
+  4,  // SetFillColor
+  1,  // SetLineWidth
+  0,  // Stroke
+  0,  // Fill
+  4,  // StrokeRect
+  4,  // FillRect
+};
+
+static_assert(arraysize(kOperandCounts) ==
+                  static_cast<size_t>(PainterCommandBuffer::Command::Count),
+              "operand counts must match commands");
+
+inline bool IsColorComponent(float value) {
+  return value >= 0 && value <= 255;
+}
+
+inline Color ReadColor(const float* p) {
+  return Color(static_cast<unsigned>(p[0]), static_cast<unsigned>(p[1]),
+               static_cast<unsigned>(p[2]), static_cast<unsigned>(p[3]));
+}
+
+inline RectF ReadRect(const float* p) {
+  return RectF(p[0], p[1], p[2], p[3]);
+}
+
+}  // namespace
+
+PainterCommandBuffer::PainterCommandBuffer() {
+}
+
+PainterCommandBuffer::~PainterCommandBuffer() {
+}
+
+void PainterCommandBuffer::Append(const float* data, size_t size) {
+  data_.insert(data_.end(), data, data + size);
+}
+
+void PainterCommandBuffer::Clear() {
+  data_.clear();
+  validated_size_ = 0;
+}
+
+bool PainterCommandBuffer::Validate(std::string* error) {
+  return ValidateCommands(data_.data(), data_.size(), &validated_size_, error);
+}
+
+// static
+bool PainterCommandBuffer::Validate(const float* data, size_t size,
+                                    std::string* error) {
+  size_t offset = 0;
+  return ValidateCommands(data, size, &offset, error);
+}
+
+bool PainterCommandBuffer::Replay(Painter* painter, std::string* error) {
+  if (!Validate(error))
+    return false;
+  ReplayValidated(painter, data_.data(), data_.size());
+  return true;
+}
+
+// static
+bool PainterCommandBuffer::Replay(Painter* painter, const float* data,
+                                  size_t size, std::string* error) {
+  size_t offset = 0;
+  if (!ValidateCommands(data, size, &offset, error))
+    return false;
+  ReplayValidated(painter, data, size);
+  return true;
+}
+
+// static
+bool PainterCommandBuffer::ValidateCommands(const float* data, size_t size,
+                                            size_t* offset,
+                                            std::string* error) {
+  size_t i = *offset;
+  while (i < size) {
+    float opcode = data[i];
+    if (!(opcode >= 0 && opcode < static_cast<int>(Command::Count)) ||
+        opcode != static_cast<int>(opcode)) {
+      *error = base::StringPrintf("Invalid opcode %g at index %d", opcode,
+                                  static_cast<int>(i));
+      return false;
+    }
+    Command command = static_cast<Command>(static_cast<int>(opcode));
+    size_t count = kOperandCounts[static_cast<int>(command)];
+    if (i + count >= size) {
+      *error = base::StringPrintf("Incomplete command at index %d",
+                                  static_cast<int>(i));
+      return false;
+    }
+    // NaN and infinity would poison the transformation and path states of
+    // painters.
+    for (size_t j = 1; j <= count; ++j) {
+      if (!std::isfinite(data[i + j])) {
+        *error = base::StringPrintf("Non-finite operand at index %d",
+                                    static_cast<int>(i + j));
+        return false;
+      }
+    }
+    if (command == Command::SetColor || command == Command::SetStrokeColor ||
+        command == Command::SetFillColor) {
+      for (size_t j = 1; j <= count; ++j) {
+        if (!IsColorComponent(data[i + j])) {
+          *error = base::StringPrintf("Invalid color component at index %d",
+                                      static_cast<int>(i + j));
+          return false;
+        }
+      }
+    }
+    i += count + 1;
+    *offset = i;
+  }
+  return true;
+}
+
+// static
+void PainterCommandBuffer::ReplayValidated(Painter* painter, const float* data,
+                                           size_t size) {
+  const float* end = data + size;
+  const float* p = data;
+  while (p < end) {
+    int command = static_cast<int>(*p++);
+    switch (static_cast<Command>(command)) {
+      case Command::Save:
+        painter->Save();
+        break;
+      case Command::Restore:
+        painter->Restore();
+        break;
+      case Command::BeginPath:
+        painter->BeginPath();
+        break;
+      case Command::ClosePath:
+        painter->ClosePath();
+        break;
+      case Command::MoveTo:
+        painter->MoveTo(PointF(p[0], p[1]));
+        break;
+      case Command::LineTo:
+        painter->LineTo(PointF(p[0], p[1]));
+        break;
+      case Command::BezierCurveTo:
+        painter->BezierCurveTo(PointF(p[0], p[1]), PointF(p[2], p[3]),
+                               PointF(p[4], p[5]));
+        break;
+      case Command::Arc:
+        painter->Arc(PointF(p[0], p[1]), p[2], p[3], p[4]);
+        break;
+      case Command::Rect:
+        painter->Rect(ReadRect(p));
+        break;
+      case Command::Clip:
+        painter->Clip();
+        break;
+      case Command::ClipRect:
+        painter->ClipRect(ReadRect(p));
+        break;
+      case Command::Translate:
+        painter->Translate(Vector2dF(p[0], p[1]));
+        break;
+      case Command::Rotate:
+        painter->Rotate(p[0]);
+        break;
+      case Command::Scale:
+        painter->Scale(Vector2dF(p[0], p[1]));
+        break;
+      case Command::SetColor:
+        painter->SetColor(ReadColor(p));
+        break;
+      case Command::SetStrokeColor:
+        painter->SetStrokeColor(ReadColor(p));
+        break;
+      case Command::SetFillColor:
+        painter->SetFillColor(ReadColor(p));
+        break;
+      case Command::SetLineWidth:
+        painter->SetLineWidth(p[0]);
+        break;
+      case Command::Stroke:
+        painter->Stroke();
+        break;
+      case Command::Fill:
+        painter->Fill();
+        break;
+      case Command::StrokeRect:
+        painter->StrokeRect(ReadRect(p));
+        break;
+      case Command::FillRect:
+        painter->FillRect(ReadRect(p));
+        break;
+      case Command::Count:
+        NOTREACHED();
+    }
+    p += kOperandCounts[command];
+  }
+}
+
+}  // namespace nu
@@ -0,0 +1,105 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_GFX_PAINTER_COMMAND_BUFFER_H_
+#define NATIVEUI_GFX_PAINTER_COMMAND_BUFFER_H_
+
+#include <string>
+#include <vector>
+
+#include "base/memory/ref_counted.h"
+#include "nativeui/nativeui_export.h"
+
+namespace nu {
+
+class Painter;
+
+// A flat array of painting commands, each command is an opcode followed by
+// its operands, all stored as floats. It is used by script bindings to paint
+// lots of shapes with one call.
+class NATIVEUI_EXPORT PainterCommandBuffer
+    : public base::RefCounted<PainterCommandBuffer> {
+ public:
+  // The opcodes, the values must not be changed since they are used by
+  // scripts directly.
+  enum class Command {
+    Save = 0,             // no operands
+    Restore = 1,          // no operands
+    BeginPath = 2,        // no operands
+    ClosePath = 3,        // no operands
+    MoveTo = 4,           // x, y
+    LineTo = 5,           // x, y
+    BezierCurveTo = 6,    // cp1x, cp1y, cp2x, cp2y, x, y
+    Arc = 7,              // x, y, radius, start angle, end angle
+    Rect = 8,             // x, y, width, height
+    Clip = 9,             // no operands
+    ClipRect = 10,        // x, y, width, height
+    Translate = 11,       // x, y
+    Rotate = 12,          // angle
+    Scale = 13,           // x, y
+    SetColor = 14,        // a, r, g, b
+    SetStrokeColor = 15,  // a, r, g, b
+    SetFillColor = 16,    // a, r, g, b
+    SetLineWidth = 17,    // width
+    Stroke = 18,          // no operands
+    Fill = 19,            // no operands
+    StrokeRect = 20,      // x, y, width, height
+    FillRect = 21,        // x, y, width, height
+    Count,
+  };
+
+  PainterCommandBuffer();
+
+  // Append commands to the buffer, the commands do not have to be complete
+  // until the buffer is replayed.
+  void Append(const float* data, size_t size);
+
+  // Remove all commands.
+  void Clear();
+
+  // Check the commands appended since last check, return false and set
+  // |error| if there is invalid command or the last command is incomplete.
+  bool Validate(std::string* error);
+
+  // Check the commands in |data| without copying them.
+  static bool Validate(const float* data, size_t size, std::string* error);
+
+  // Validate and paint the commands on |painter|, nothing is painted if the
+  // commands are invalid.
+  bool Replay(Painter* painter, std::string* error);
+
+  // Validate and paint the commands in |data| without copying them.
+  static bool Replay(Painter* painter, const float* data, size_t size,
+                     std::string* error);
+
+  // Return the commands in the buffer.
+  const float* data() const { return data_.data(); }
+
+  // Return the number of floats in the buffer.
+  size_t size() const { return data_.size(); }
+
+ protected:
+  virtual ~PainterCommandBuffer();
+
+ private:
+  friend class base::RefCounted<PainterCommandBuffer>;
+
+  // Check the commands in |data| starting from |*offset|, which is updated to
+  // the end of last complete command.
+  static bool ValidateCommands(const float* data, size_t size, size_t* offset,
+                               std::string* error);
+
+  // Paint the commands that have been validated.
+  static void ReplayValidated(Painter* painter, const float* data,
+                              size_t size);
+
+  std::vector<float> data_;
+
+  // The commands before this offset have been validated.
+  size_t validated_size_ = 0;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_GFX_PAINTER_COMMAND_BUFFER_H_
@@ -0,0 +1,85 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <cmath>
+
+#include "nativeui/gfx/display_list.h"
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class PainterCommandBufferTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    buffer_ = new nu::PainterCommandBuffer;
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::PainterCommandBuffer> buffer_;
+};
+
+TEST_F(PainterCommandBufferTest, Replay) {
+  const float commands[] = {
+    0,                   // Save
+    16, 255, 255, 0, 0,  // SetFillColor
+    2,                   // BeginPath
+    4, 0, 0,             // MoveTo
+    5, 10, 10,           // LineTo
+    19,                  // Fill
+    21, 0, 0, 5, 5,      // FillRect
+    1,                   // Restore
+  };
+  buffer_->Append(commands, arraysize(commands));
+  nu::DisplayList list;
+  std::string error;
+  EXPECT_TRUE(buffer_->Replay(&list, &error));
+  EXPECT_EQ(list.size(), 8u);
+
+  // Replay again without validating.
+  list.Clear();
+  EXPECT_TRUE(buffer_->Replay(&list, &error));
+  EXPECT_EQ(list.size(), 8u);
+
+  list.Clear();
+  EXPECT_TRUE(nu::PainterCommandBuffer::Replay(&list, commands,
+                                               arraysize(commands), &error));
+  EXPECT_EQ(list.size(), 8u);
+}
+
+TEST_F(PainterCommandBufferTest, IncompleteCommand) {
+  const float commands[] = { 4, 1 };
+  buffer_->Append(commands, 2);
+  nu::DisplayList list;
+  std::string error;
+  EXPECT_FALSE(buffer_->Replay(&list, &error));
+  EXPECT_EQ(list.size(), 0u);
+  EXPECT_FALSE(error.empty());
+
+  // Finish the command.
+  const float rest[] = { 2 };
+  buffer_->Append(rest, 1);
+  EXPECT_TRUE(buffer_->Replay(&list, &error));
+  EXPECT_EQ(list.size(), 1u);
+}
+
+TEST_F(PainterCommandBufferTest, InvalidCommand) {
+  nu::DisplayList list;
+  std::string error;
+  const float invalid_opcode[] = { 0, 1.5f };
+  EXPECT_FALSE(nu::PainterCommandBuffer::Replay(&list, invalid_opcode, 2,
+                                                &error));
+  const float unknown_opcode[] = { 100 };
+  EXPECT_FALSE(nu::PainterCommandBuffer::Replay(&list, unknown_opcode, 1,
+                                                &error));
+  const float invalid_color[] = { 14, 255, 256, 0, 0 };
+  EXPECT_FALSE(nu::PainterCommandBuffer::Replay(&list, invalid_color, 5,
+                                                &error));
+  const float nan_operand[] = { 4, 1, NAN };
+  EXPECT_FALSE(nu::PainterCommandBuffer::Replay(&list, nan_operand, 3,
+                                                &error));
+  const float infinite_operand[] = { 12, INFINITY };
+  EXPECT_FALSE(nu::PainterCommandBuffer::Replay(&list, infinite_operand, 2,
+                                                &error));
+  EXPECT_EQ(list.size(), 0u);
+}
@@ -0,0 +1,69 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_GFX_PATH_H_
+#define NATIVEUI_GFX_PATH_H_
+
+#include "base/memory/ref_counted.h"
+#include "nativeui/gfx/geometry/rect_f.h"
+#include "nativeui/nativeui_export.h"
+#include "nativeui/types.h"
+
+namespace nu {
+
+// A path that is built once and can be painted for many times with
+// Painter::FillPath, Painter::StrokePath and Painter::ClipPath.
+class NATIVEUI_EXPORT Path : public base::RefCounted<Path> {
+ public:
+  Path();
+
+  // Path operations, they work the same with the ones of Painter.
+  void MoveTo(const PointF& p);
+  void LineTo(const PointF& p);
+  void BezierCurveTo(const PointF& cp1, const PointF& cp2, const PointF& ep);
+  void Arc(const PointF& point, float radius, float sa, float ea);
+  void Rect(const RectF& rect);
+  void ClosePath();
+
+  // Remove all segments.
+  void Clear();
+
+  // Return a copy of the path, which is not affected by later changes.
+  scoped_refptr<Path> Clone() const;
+
+  // Return the area covered by the path.
+  RectF GetBounds() const;
+
+  // Return the native path, which must not be modified.
+  NativePath GetNative() const;
+
+ private:
+  friend class base::RefCounted<Path>;
+
+  ~Path();
+
+#if defined(OS_LINUX)
+  // Forget the copied path after the path is changed.
+  void DiscardCopy();
+
+  // The path is built on a context, and copied out when it is painted.
+  cairo_t* context_;
+  mutable NativePath path_ = nullptr;
+#else
+  NativePath path_;
+#endif
+
+#if defined(OS_WIN)
+  // GDI+ does not record current point for MoveTo.
+  bool has_current_point_ = false;
+  PointF current_point_;
+  PointF figure_start_;
+#endif
+
+  DISALLOW_COPY_AND_ASSIGN(Path);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_GFX_PATH_H_
@@ -0,0 +1,79 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/display_list.h"
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class PathTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    path_ = new nu::Path;
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::Path> path_;
+};
+
+TEST_F(PathTest, GetBounds) {
+  EXPECT_TRUE(path_->GetBounds().IsEmpty());
+  path_->MoveTo(nu::PointF(10, 10));
+  path_->LineTo(nu::PointF(30, 10));
+  path_->LineTo(nu::PointF(30, 50));
+  path_->ClosePath();
+  EXPECT_EQ(path_->GetBounds(), nu::RectF(10, 10, 20, 40));
+  path_->Rect(nu::RectF(0, 0, 5, 5));
+  EXPECT_EQ(path_->GetBounds(), nu::RectF(0, 0, 30, 50));
+  path_->Clear();
+  EXPECT_TRUE(path_->GetBounds().IsEmpty());
+}
+
+TEST_F(PathTest, FillPath) {
+  path_->Rect(nu::RectF(0, 0, 2, 2));
+  scoped_refptr<nu::Canvas> canvas(new nu::Canvas(nu::SizeF(4, 4), 1.f));
+  nu::Painter* painter = canvas->GetPainter();
+  painter->SetFillColor(nu::Color(255, 0, 0));
+  painter->FillPath(path_.get());
+  // The path can be painted again after being changed.
+  path_->Clear();
+  path_->Rect(nu::RectF(2, 2, 2, 2));
+  painter->FillPath(path_.get());
+
+  nu::Canvas::PixelBuffer pixels = canvas->LockPixels();
+  uint32_t* memory = reinterpret_cast<uint32_t*>(pixels.data);
+  EXPECT_EQ(memory[0], 0xFFFF0000);
+  EXPECT_EQ(memory[3], 0u);
+  EXPECT_EQ(memory[3 * pixels.stride / 4 + 3], 0xFFFF0000);
+  canvas->UnlockPixels();
+}
+
+TEST_F(PathTest, Record) {
+  nu::DisplayList list;
+  list.FillPath(path_.get());
+  list.StrokePath(path_.get());
+  list.ClipPath(path_.get());
+  EXPECT_EQ(list.size(), 3u);
+  nu::DisplayList copy;
+  list.Replay(&copy);
+  EXPECT_EQ(copy.size(), 3u);
+}
+
+TEST_F(PathTest, RecordCopiesPath) {
+  path_->Rect(nu::RectF(0, 0, 2, 2));
+  nu::DisplayList list;
+  list.SetFillColor(nu::Color(255, 0, 0));
+  list.FillPath(path_.get());
+  // Changing the path does not change what was recorded.
+  path_->Clear();
+  path_->Rect(nu::RectF(2, 2, 2, 2));
+
+  scoped_refptr<nu::Canvas> canvas(new nu::Canvas(nu::SizeF(4, 4), 1.f));
+  list.Replay(canvas->GetPainter());
+  nu::Canvas::PixelBuffer pixels = canvas->LockPixels();
+  uint32_t* memory = reinterpret_cast<uint32_t*>(pixels.data);
+  EXPECT_EQ(memory[0], 0xFFFF0000);
+  EXPECT_EQ(memory[3 * pixels.stride / 4 + 3], 0u);
+  canvas->UnlockPixels();
+}
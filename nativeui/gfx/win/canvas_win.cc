@@ -17,9 +17,23 @@ const float kDefaultDPI = 96.f;
 // static
 NativeBitmap Canvas::PlatformCreateBitmap(const SizeF& size,
                                           float scale_factor) {
+  // Use premultiplied alpha, which is the format of other platforms and is
+  // also faster to draw.
   NativeBitmap bitmap = new Gdiplus::Bitmap(size.width() * scale_factor,
                                             size.height() * scale_factor,
-                                            PixelFormat32bppARGB);
+                                            PixelFormat32bppPARGB);
+  float dpi = kDefaultDPI * scale_factor;
+  bitmap->SetResolution(dpi, dpi);
+  return bitmap;
+}
+
+// static
+NativeBitmap Canvas::PlatformCreateBitmapFromPixels(const PixelBuffer& pixels,
+                                                    float scale_factor) {
+  NativeBitmap bitmap = new Gdiplus::Bitmap(pixels.width, pixels.height,
+                                            pixels.stride,
+                                            PixelFormat32bppPARGB,
+                                            pixels.data);
   float dpi = kDefaultDPI * scale_factor;
   bitmap->SetResolution(dpi, dpi);
   return bitmap;
@@ -36,4 +50,24 @@ Painter* Canvas::PlatformCreatePainter(NativeBitmap bitmap,
   return new PainterWin(bitmap, scale_factor);
 }
 
+Canvas::PixelBuffer Canvas::PlatformLockPixels() {
+  static_cast<PainterWin*>(painter_.get())->Flush();
+  Gdiplus::Rect rect(0, 0, bitmap_->GetWidth(), bitmap_->GetHeight());
+  bitmap_data_.reset(new Gdiplus::BitmapData);
+  bitmap_->LockBits(&rect,
+                    Gdiplus::ImageLockModeRead | Gdiplus::ImageLockModeWrite,
+                    PixelFormat32bppPARGB, bitmap_data_.get());
+  PixelBuffer pixels;
+  pixels.data = static_cast<uint8_t*>(bitmap_data_->Scan0);
+  pixels.width = bitmap_data_->Width;
+  pixels.height = bitmap_data_->Height;
+  pixels.stride = bitmap_data_->Stride;
+  return pixels;
+}
+
+void Canvas::PlatformUnlockPixels(const Rect& dirty) {
+  bitmap_->UnlockBits(bitmap_data_.get());
+  bitmap_data_.reset();
+}
+
 }  // namespace nu
@@ -84,4 +84,27 @@ NativeFont Font::GetNative() const {
   return font_;
 }
 
+FontMetrics Font::PlatformGetMetrics() const {
+  base::win::ScopedGetDC screen_dc(NULL);
+  LOGFONTW logfont;
+  {
+    Gdiplus::Graphics graphics(screen_dc);
+    font_->GetLogFontW(&graphics, &logfont);
+  }
+
+  TEXTMETRIC fm;
+  base::win::ScopedHFONT font(CreateFontIndirectW(&logfont));
+  ScopedSetMapMode mode(screen_dc, MM_TEXT);
+  base::win::ScopedSelectObject scoped_font(screen_dc, font.get());
+  ::GetTextMetrics(screen_dc, &fm);
+
+  // Converting pixels to DIPs.
+  float scale_factor = ::GetDeviceCaps(screen_dc, LOGPIXELSY) / 96.f;
+  FontMetrics result;
+  result.ascent = fm.tmAscent / scale_factor;
+  result.descent = fm.tmDescent / scale_factor;
+  result.average_char_width = fm.tmAveCharWidth / scale_factor;
+  return result;
+}
+
 }  // namespace nu
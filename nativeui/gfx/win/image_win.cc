@@ -4,6 +4,8 @@
 
 #include "nativeui/gfx/image.h"
 
+#include <shlwapi.h>
+
 #include "nativeui/gfx/win/gdiplus.h"
 
 namespace nu {
@@ -23,8 +25,62 @@ SizeF Image::GetSize() const {
                    1.f / scale_factor_);
 }
 
+void Image::SetMipmapped(bool mipmapped) {
+  // GDI+ prefilters the image when drawing it downscaled.
+  mipmapped_ = mipmapped;
+}
+
 NativeImage Image::GetNative() const {
   return image_;
 }
 
+// static
+NativeImage Image::PlatformDecodeBuffer(const void* data, size_t size,
+                                        float scale_factor) {
+  // GDI+ reads from the stream lazily and keeps a reference to it, the stream
+  // owns a copy of |data|.
+  IStream* stream = ::SHCreateMemStream(static_cast<const BYTE*>(data),
+                                        static_cast<UINT>(size));
+  if (!stream)
+    return nullptr;
+  Gdiplus::Image* image = new Gdiplus::Image(stream);
+  stream->Release();
+  if (image->GetLastStatus() != Gdiplus::Ok) {
+    delete image;
+    return nullptr;
+  }
+  return image;
+}
+
+// static
+NativeImage Image::PlatformDecodeFile(const base::FilePath& path,
+                                      float* scale_factor) {
+  Gdiplus::Image* image = new Gdiplus::Image(path.value().c_str());
+  if (image->GetLastStatus() != Gdiplus::Ok) {
+    delete image;
+    return nullptr;
+  }
+  *scale_factor = GetScaleFactorFromFilePath(path);
+  return image;
+}
+
+// static
+NativeImage Image::PlatformDecodeFileAtSize(const base::FilePath& path,
+                                            const Size& size,
+                                            float scale_factor) {
+  Gdiplus::Image image(path.value().c_str());
+  if (image.GetLastStatus() != Gdiplus::Ok)
+    return nullptr;
+  // GDI+ can not decode at a smaller size, draw the image into a smaller
+  // bitmap so the full size one is not kept in memory.
+  Size fit_size = GetFitSize(Size(image.GetWidth(), image.GetHeight()), size);
+  Gdiplus::Bitmap* bitmap = new Gdiplus::Bitmap(
+      fit_size.width(), fit_size.height(), PixelFormat32bppPARGB);
+  Gdiplus::Graphics graphics(bitmap);
+  graphics.SetInterpolationMode(Gdiplus::InterpolationModeHighQualityBicubic);
+  graphics.SetPixelOffsetMode(Gdiplus::PixelOffsetModeHalf);
+  graphics.DrawImage(&image, 0, 0, fit_size.width(), fit_size.height());
+  return bitmap;
+}
+
 }  // namespace nu
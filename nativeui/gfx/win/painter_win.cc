@@ -18,6 +18,7 @@
 #include "nativeui/gfx/geometry/rect_conversions.h"
 #include "nativeui/gfx/geometry/vector2d_conversions.h"
 #include "nativeui/gfx/image.h"
+#include "nativeui/gfx/path.h"
 #include "nativeui/state.h"
 
 namespace nu {
@@ -74,6 +75,10 @@ void PainterWin::DrawFocusRect(const nu::Rect& rect) {
   ReleaseHDC(hdc);
 }
 
+void PainterWin::Flush() {
+  graphics_.Flush(Gdiplus::FlushIntentionSync);
+}
+
 void PainterWin::Save() {
   states_.push(top());
   top().state = graphics_.Save();
@@ -131,6 +136,10 @@ void PainterWin::ClipRect(const RectF& rect) {
   ClipRectPixel(ToEnclosingRect(ScaleRect(rect, scale_factor_)));
 }
 
+bool PainterWin::QuickReject(const RectF& rect) {
+  return !graphics_.IsVisible(ToGdi(ScaleRect(rect, scale_factor_)));
+}
+
 void PainterWin::Translate(const Vector2dF& offset) {
   TranslatePixel(ToFlooredVector2d(ScaleVector2d(offset, scale_factor_)));
 }
@@ -172,6 +181,29 @@ void PainterWin::Fill() {
   path_.Reset();
 }
 
+void PainterWin::StrokePath(Path* path) {
+  std::unique_ptr<Gdiplus::GraphicsPath> pixel_path(GetPixelPath(path));
+  Gdiplus::Pen pen(ToGdi(top().stroke_color), top().line_width);
+  graphics_.DrawPath(&pen, pixel_path.get());
+  use_gdi_current_point_ = true;
+  path_.Reset();
+}
+
+void PainterWin::FillPath(Path* path) {
+  std::unique_ptr<Gdiplus::GraphicsPath> pixel_path(GetPixelPath(path));
+  Gdiplus::SolidBrush brush(ToGdi(top().fill_color));
+  graphics_.FillPath(&brush, pixel_path.get());
+  use_gdi_current_point_ = true;
+  path_.Reset();
+}
+
+void PainterWin::ClipPath(Path* path) {
+  std::unique_ptr<Gdiplus::GraphicsPath> pixel_path(GetPixelPath(path));
+  graphics_.SetClip(pixel_path.get(), Gdiplus::CombineModeIntersect);
+  use_gdi_current_point_ = true;
+  path_.Reset();
+}
+
 void PainterWin::StrokeRect(const RectF& rect) {
   StrokeRectPixel(ToEnclosingRect(ScaleRect(rect, scale_factor_)));
 }
@@ -202,8 +234,11 @@ void PainterWin::DrawCanvas(Canvas* canvas, const RectF& rect) {
 void PainterWin::DrawCanvasFromRect(Canvas* canvas, const RectF& src,
                                     const RectF& dest) {
   RectF ps = ScaleRect(src, canvas->GetScaleFactor());
+  // Translations are in whole pixels, so rounding the edges is enough to
+  // avoid resampling the bitmap.
+  RectF pixel_dest(ToNearestRect(ScaleRect(dest, scale_factor_)));
   graphics_.DrawImage(canvas->GetBitmap(),
-                      ToGdi(ScaleRect(dest, scale_factor_)),
+                      ToGdi(pixel_dest),
                       ps.x(), ps.y(), ps.width(), ps.height(),
                       Gdiplus::UnitPixel);
 }
@@ -344,6 +379,13 @@ void PainterWin::Initialize(float scale_factor) {
   states_.emplace(scale_factor, Color(), Color());
 }
 
+Gdiplus::GraphicsPath* PainterWin::GetPixelPath(Path* path) {
+  Gdiplus::GraphicsPath* pixel_path = path->GetNative()->Clone();
+  Gdiplus::Matrix matrix(scale_factor_, 0, 0, scale_factor_, 0, 0);
+  pixel_path->Transform(&matrix);
+  return pixel_path;
+}
+
 bool PainterWin::GetCurrentPoint(Gdiplus::PointF* point) {
   if (use_gdi_current_point_) {
     Gdiplus::Status status = path_.GetLastPoint(point);
@@ -32,6 +32,9 @@ class PainterWin : public Painter {
   // Draw the focus rect.
   void DrawFocusRect(const nu::Rect& rect);
 
+  // Wait until all pending painting is finished.
+  void Flush();
+
   // Painter:
   void Save() override;
   void Restore() override;
@@ -46,6 +49,7 @@ class PainterWin : public Painter {
   void Rect(const RectF& rect) override;
   void Clip() override;
   void ClipRect(const RectF& rect) override;
+  bool QuickReject(const RectF& rect) override;
   void Translate(const Vector2dF& offset) override;
   void Rotate(float angle) override;
   void Scale(const Vector2dF& scale) override;
@@ -55,6 +59,9 @@ class PainterWin : public Painter {
   void SetLineWidth(float width) override;
   void Stroke() override;
   void Fill() override;
+  void StrokePath(Path* path) override;
+  void FillPath(Path* path) override;
+  void ClipPath(Path* path) override;
   void StrokeRect(const RectF& rect) override;
   void FillRect(const RectF& rect) override;
   void DrawImage(Image* image, const RectF& rect) override;
@@ -88,6 +95,9 @@ class PainterWin : public Painter {
   // Used for common initialization.
   void Initialize(float scale_factor);
 
+  // Return a copy of |path| in pixels.
+  Gdiplus::GraphicsPath* GetPixelPath(Path* path);
+
   // Get current point.
   bool GetCurrentPoint(Gdiplus::PointF* point);
 
@@ -0,0 +1,100 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/path.h"
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+#include "nativeui/gfx/win/gdiplus.h"
+
+namespace nu {
+
+Path::Path() : path_(new Gdiplus::GraphicsPath) {
+}
+
+Path::~Path() {
+  delete path_;
+}
+
+void Path::MoveTo(const PointF& p) {
+  path_->StartFigure();
+  has_current_point_ = true;
+  current_point_ = p;
+  figure_start_ = p;
+}
+
+void Path::LineTo(const PointF& p) {
+  if (!has_current_point_) {
+    MoveTo(p);
+    return;
+  }
+  path_->AddLine(ToGdi(current_point_), ToGdi(p));
+  current_point_ = p;
+}
+
+void Path::BezierCurveTo(const PointF& cp1,
+                         const PointF& cp2,
+                         const PointF& ep) {
+  if (!has_current_point_)
+    MoveTo(cp1);
+  path_->AddBezier(ToGdi(current_point_), ToGdi(cp1), ToGdi(cp2), ToGdi(ep));
+  current_point_ = ep;
+}
+
+void Path::Arc(const PointF& point, float radius, float sa, float ea) {
+  // Normalize the angle.
+  if (ea < sa) {
+    while (ea <= sa)
+      ea += 2.0f * static_cast<float>(M_PI);
+  }
+  float angle = ea - sa;
+
+  // Should draw a line connecting previous point.
+  LineTo(PointF(point.x() + radius * cos(sa), point.y() + radius * sin(sa)));
+
+  path_->AddArc(point.x() - radius, point.y() - radius,
+                2.0f * radius, 2.0f * radius,
+                sa / M_PI * 180.0f, angle / M_PI * 180.0f);
+  current_point_ = PointF(point.x() + radius * cos(ea),
+                          point.y() + radius * sin(ea));
+}
+
+void Path::Rect(const RectF& rect) {
+  path_->AddRectangle(ToGdi(rect));
+  // Adding rectangle should update current point.
+  MoveTo(rect.origin());
+}
+
+void Path::ClosePath() {
+  path_->CloseFigure();
+  current_point_ = figure_start_;
+}
+
+void Path::Clear() {
+  path_->Reset();
+  has_current_point_ = false;
+}
+
+scoped_refptr<Path> Path::Clone() const {
+  scoped_refptr<Path> path(new Path);
+  delete path->path_;
+  path->path_ = path_->Clone();
+  path->has_current_point_ = has_current_point_;
+  path->current_point_ = current_point_;
+  path->figure_start_ = figure_start_;
+  return path;
+}
+
+RectF Path::GetBounds() const {
+  Gdiplus::RectF bounds;
+  path_->GetBounds(&bounds);
+  return RectF(bounds.X, bounds.Y, bounds.Width, bounds.Height);
+}
+
+NativePath Path::GetNative() const {
+  return path_;
+}
+
+}  // namespace nu
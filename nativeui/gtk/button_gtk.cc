@@ -27,6 +27,7 @@ Button::Button(const std::string& title, Type type) {
     TakeOverView(gtk_check_button_new_with_label(title.c_str()));
   else if (type == Type::Radio)
     TakeOverView(gtk_radio_button_new_with_label(nullptr, title.c_str()));
+  UseMeasureFunc();
   UpdateDefaultStyle();
   g_signal_connect(GetNative(), "clicked", G_CALLBACK(OnClick), this);
 }
@@ -41,4 +41,48 @@ void Container::PlatformRemoveChildView(View* child) {
   gtk_container_remove(GTK_CONTAINER(GetNative()), child->GetNative());
 }
 
+void Container::PlatformRemoveAllChildViews() {
+  GtkContainer* container = GTK_CONTAINER(GetNative());
+  for (const auto& child : children_)
+    gtk_container_remove(container, child->GetNative());
+}
+
+void Container::PlatformAddChildViews(const std::vector<View*>& views) {
+  // Find the radio group once instead of searching for every new child.
+  GtkRadioButton* group = nullptr;
+  for (int i = 0; i < ChildCount(); ++i) {
+    GtkWidget* widget = ChildAt(i)->GetNative();
+    if (GTK_IS_RADIO_BUTTON(widget)) {
+      group = GTK_RADIO_BUTTON(widget);
+      break;
+    }
+  }
+
+  GtkWidget* container = GetNative();
+  for (View* child : views) {
+    GtkWidget* widget = child->GetNative();
+    if (GTK_IS_RADIO_BUTTON(widget) && group != GTK_RADIO_BUTTON(widget))
+      gtk_radio_button_join_group(GTK_RADIO_BUTTON(widget), group);
+    gtk_container_add(GTK_CONTAINER(container), widget);
+  }
+}
+
+void Container::PlatformMoveChildView(View* child, int index) {
+  // Drawing follows the order of children, but the GDK windows of children,
+  // which receive input, are stacked in the order they are realized. Adding
+  // the children again restacks the windows of the moved one and the ones
+  // after it.
+  GtkWidget* container = GetNative();
+  if (!gtk_widget_get_realized(container))
+    return;
+  for (int i = index; i < ChildCount(); ++i) {
+    View* view = ChildAt(i);
+    GtkWidget* widget = view->GetNative();
+    g_object_ref(widget);
+    gtk_container_remove(GTK_CONTAINER(container), widget);
+    gtk_container_add(GTK_CONTAINER(container), widget);
+    g_object_unref(widget);
+  }
+}
+
 }  // namespace nu
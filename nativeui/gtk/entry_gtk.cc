@@ -24,6 +24,7 @@ void OnTextChange(GtkEditable*, Entry* entry) {
 
 Entry::Entry() {
   TakeOverView(gtk_entry_new());
+  UseMeasureFunc();
   UpdateDefaultStyle();
 
   g_signal_connect(GetNative(), "activate", G_CALLBACK(OnActivate), this);
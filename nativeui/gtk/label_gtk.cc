@@ -6,12 +6,30 @@
 
 #include <gtk/gtk.h>
 
-#include "nativeui/gtk/widget_util.h"
+#include <algorithm>
 
 namespace nu {
 
+namespace {
+
+// Return the padding and border that the theme draws around the text.
+GtkBorder GetLabelInsets(GtkWidget* widget) {
+  GtkStyleContext* context = gtk_widget_get_style_context(widget);
+  GtkStateFlags state = gtk_style_context_get_state(context);
+  GtkBorder padding, border;
+  gtk_style_context_get_padding(context, state, &padding);
+  gtk_style_context_get_border(context, state, &border);
+  return { static_cast<gint16>(padding.left + border.left),
+           static_cast<gint16>(padding.right + border.right),
+           static_cast<gint16>(padding.top + border.top),
+           static_cast<gint16>(padding.bottom + border.bottom) };
+}
+
+}  // namespace
+
 Label::Label(const std::string& text) {
   TakeOverView(gtk_label_new(text.c_str()));
+  UseMeasureFunc();
   UpdateDefaultStyle();
   // Create GdkWindow for label, otherwise it can not receive input events.
   gtk_widget_set_has_window(GetNative(), true);
@@ -28,8 +46,26 @@ std::string Label::GetText() const {
   return gtk_label_get_text(GTK_LABEL(GetNative()));
 }
 
-SizeF Label::GetMinimumSize() const {
-  return GetPreferredSizeForWidget(GetNative());
+void Label::PlatformSetWrapping(bool wrap) {
+  gtk_label_set_line_wrap(GTK_LABEL(GetNative()), wrap);
+  gtk_label_set_line_wrap_mode(GTK_LABEL(GetNative()), PANGO_WRAP_WORD_CHAR);
+}
+
+SizeF Label::PlatformMeasure(float width) const {
+  // Measure with pango directly instead of asking GTK for the preferred size,
+  // and add the padding and border like GTK does.
+  GtkBorder insets = GetLabelInsets(GetNative());
+  PangoLayout* layout = gtk_widget_create_pango_layout(
+      GetNative(), gtk_label_get_text(GTK_LABEL(GetNative())));
+  if (width >= 0) {
+    float text_width = std::max(width - insets.left - insets.right, 0.f);
+    pango_layout_set_width(layout, text_width * PANGO_SCALE);
+    pango_layout_set_wrap(layout, PANGO_WRAP_WORD_CHAR);
+  }
+  int w, h;
+  pango_layout_get_pixel_size(layout, &w, &h);
+  g_object_unref(layout);
+  return SizeF(w + insets.left + insets.right, h + insets.top + insets.bottom);
 }
 
 }  // namespace nu
@@ -45,4 +45,11 @@ void Lifetime::PostDelayedTask(int ms, const Task& task) {
                      new Task(task), Delete<Task>);
 }
 
+void Lifetime::PostIdleTask(const Task& task) {
+  // Same with GTK's resize priority, which runs before GDK_PRIORITY_REDRAW.
+  g_idle_add_full(G_PRIORITY_HIGH_IDLE + 10,
+                  reinterpret_cast<GSourceFunc>(OnSource),
+                  new Task(task), Delete<Task>);
+}
+
 }  // namespace nu
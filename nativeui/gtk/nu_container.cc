@@ -145,9 +145,27 @@ static void nu_container_size_allocate(GtkWidget* widget,
 
   // Though nu::Container::OnSizeChanged is responsible for setting the
   // sizes of children, we have to allocate size here otherwise children
-  // may have problems rendering.
+  // may have problems rendering. Children whose bounds do not change are
+  // skipped when applying the layout.
   NUContainerPrivate* priv = NU_CONTAINER(widget)->priv;
-  priv->delegate->SetChildBoundsFromCSS();
+  Container* delegate = priv->delegate;
+  delegate->SetChildBoundsFromCSS();
+
+  // GTK requires every visible child to be allocated in size_allocate, so
+  // the unchanged allocations are issued again. GTK returns early for the
+  // children that have just been allocated.
+  for (int i = 0; i < delegate->ChildCount(); ++i) {
+    GtkWidget* child = delegate->ChildAt(i)->GetNative();
+    if (!gtk_widget_get_visible(child))
+      continue;
+    GtkAllocation child_allocation;
+    gtk_widget_get_allocation(child, &child_allocation);
+    // The size requests are cached by GTK unless the child queued a resize.
+    gint tmp;
+    gtk_widget_get_preferred_width(child, &tmp, nullptr);
+    gtk_widget_get_preferred_height(child, &tmp, nullptr);
+    gtk_widget_size_allocate(child, &child_allocation);
+  }
 
   if (gtk_widget_get_realized(widget) && priv->event_window) {
     gdk_window_move_resize(priv->event_window,
@@ -166,9 +184,15 @@ static gboolean nu_container_draw(GtkWidget* widget, cairo_t* cr) {
   gtk_render_background(gtk_widget_get_style_context(widget), cr,
                         0, 0, width, height);
 
+  // Only the damaged area needs to be painted.
+  double x1, y1, x2, y2;
+  cairo_clip_extents(cr, &x1, &y1, &x2, &y2);
+  RectF dirty(x1, y1, x2 - x1, y2 - y1);
+  dirty.Intersect(RectF(0, 0, width, height));
+
   Container* delegate = NU_CONTAINER(widget)->priv->delegate;
   PainterGtk painter(cr);
-  delegate->on_draw.Emit(delegate, &painter, nu::RectF(0, 0, width, height));
+  delegate->Draw(&painter, dirty);
 
   for (int i = 0; i < delegate->ChildCount(); ++i)
     gtk_container_propagate_draw(GTK_CONTAINER(widget),
@@ -4,9 +4,17 @@
 
 #include "nativeui/state.h"
 
+#include "nativeui/gfx/gtk/pango_layout_cache.h"
+
 namespace nu {
 
 void State::PlatformInit() {
 }
 
+PangoLayoutCache* State::GetPangoLayoutCache() {
+  if (!pango_layout_cache_)
+    pango_layout_cache_.reset(new PangoLayoutCache);
+  return pango_layout_cache_.get();
+}
+
 }  // namespace nu
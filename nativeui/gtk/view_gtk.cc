@@ -154,6 +154,10 @@ RectF View::GetBounds() const {
   return RectF(GetPixelBounds());
 }
 
+bool View::IsBoundsChangedBy(const RectF& bounds) const {
+  return GetPixelBounds() != ToNearestRect(bounds);
+}
+
 void View::SetPixelBounds(const Rect& bounds) {
   // The size allocation is relative to the window instead of parent.
   GdkRectangle rect = bounds.ToGdkRectangle();
@@ -164,6 +168,13 @@ void View::SetPixelBounds(const Rect& bounds) {
     rect.y += pb.y;
   }
 
+  // Requesting and allocating size are expensive, skip them when nothing
+  // would change.
+  GdkRectangle current;
+  gtk_widget_get_allocation(view_, &current);
+  if (gdk_rectangle_equal(&current, &rect))
+    return;
+
   // Call get_preferred_width before size allocation, otherwise GTK would print
   // warnings like "How does the code know the size to allocate?".
   gint tmp;
@@ -195,6 +206,14 @@ void View::SchedulePaint() {
   gtk_widget_queue_draw(view_);
 }
 
+void View::SchedulePaintRect(const RectF& rect) {
+  // GTK expects the area in widget coordinates, and unions it with other
+  // queued areas.
+  Rect area = ToEnclosingRect(rect);
+  gtk_widget_queue_draw_area(view_, area.x(), area.y(),
+                             area.width(), area.height());
+}
+
 void View::PlatformSetVisible(bool visible) {
   gtk_widget_set_visible(view_, visible);
 }
@@ -261,8 +280,7 @@ bool View::IsMouseDownCanMoveWindow() const {
   return g_object_get_data(G_OBJECT(view_), "draggable");
 }
 
-void View::SetFont(Font* font) {
-  font_ = font;
+void View::PlatformSetFont(Font* font) {
   gtk_widget_override_font(view_, font->GetNative());
 }
 
@@ -4,9 +4,15 @@
 
 #include "nativeui/gtk/widget_util.h"
 
+#include <vector>
+
 #include "base/logging.h"
 #include "nativeui/gfx/color.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #ifdef GDK_WINDOWING_X11
 #include <gdk/gdkx.h>
 #include <X11/Xatom.h>  // XA_CARDINAL
@@ -29,6 +35,102 @@ bool CairoSurfaceExtents(cairo_surface_t* surface, GdkRectangle* extents) {
   return true;
 }
 
+// Return the first pixel in [x, end) of |row| that is (or is not when
+// |transparent| is false) fully transparent, or |end| if there is none.
+inline int FindPixel(const uint8_t* row, int x, int end, bool transparent) {
+#if defined(__SSE2__)
+  // Compare 16 pixels at once.
+  const __m128i zero = _mm_setzero_si128();
+  for (; x + 16 <= end; x += 16) {
+    __m128i pixels =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x));
+    int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(pixels, zero));
+    if (!transparent)
+      mask = ~mask & 0xFFFF;
+    if (mask)
+      return x + __builtin_ctz(mask);
+  }
+#endif
+  for (; x < end; ++x) {
+    if ((row[x] == 0) == transparent)
+      return x;
+  }
+  return end;
+}
+
+// Collect the rectangles covering non-transparent pixels of A8 |data|.
+// Runs of each row are found first, and rows that have exactly the same runs
+// with the previous row extend the rectangles of previous row downward.
+void ScanRegionRects(const uint8_t* data, int stride, int width, int height,
+                     std::vector<GdkRectangle>* rects) {
+  size_t last_row = 0;
+  std::vector<GdkRectangle> runs;
+  for (int y = 0; y < height; ++y) {
+    const uint8_t* row = data + y * stride;
+    runs.clear();
+    int x = 0;
+    while (x < width) {
+      // Only full-transparent pixels are treated as transparent, this is to
+      // match the behavior of macOS and Win32.
+      int start = FindPixel(row, x, width, false);
+      if (start == width)
+        break;
+      x = FindPixel(row, start, width, true);
+      runs.push_back({start, y, x - start, 1});
+    }
+
+    bool same_as_last_row = rects->size() - last_row == runs.size();
+    for (size_t i = 0; same_as_last_row && i < runs.size(); ++i) {
+      const GdkRectangle& rect = (*rects)[last_row + i];
+      same_as_last_row = rect.x == runs[i].x && rect.width == runs[i].width;
+    }
+    if (same_as_last_row) {
+      for (size_t i = last_row; i < rects->size(); ++i)
+        (*rects)[i].height++;
+    } else {
+      last_row = rects->size();
+      rects->insert(rects->end(), runs.begin(), runs.end());
+    }
+  }
+}
+
+// Create region from the non-transparent pixels of |surface| in |area|.
+cairo_region_t* CreateRegionFromArea(cairo_surface_t* surface,
+                                     const GdkRectangle& area) {
+  std::vector<GdkRectangle> rects;
+  if (cairo_surface_get_type(surface) == CAIRO_SURFACE_TYPE_IMAGE &&
+      cairo_image_surface_get_format(surface) == CAIRO_FORMAT_A8) {
+    // Read the pixels in |area| directly.
+    double dx = 0, dy = 0;
+    cairo_surface_get_device_offset(surface, &dx, &dy);
+    cairo_surface_flush(surface);
+    int stride = cairo_image_surface_get_stride(surface);
+    const uint8_t* data = cairo_image_surface_get_data(surface) +
+                          static_cast<int>(area.y + dy) * stride +
+                          static_cast<int>(area.x + dx);
+    ScanRegionRects(data, stride, area.width, area.height, &rects);
+  } else {
+    // We work on A8 images to get full alpha channel, only the pixels in
+    // |area| are copied.
+    cairo_surface_t* image = cairo_image_surface_create(
+        CAIRO_FORMAT_A8, area.width, area.height);
+    cairo_t* cr = cairo_create(image);
+    cairo_set_source_surface(cr, surface, -area.x, -area.y);
+    cairo_paint(cr);
+    cairo_surface_flush(image);
+    cairo_destroy(cr);
+    ScanRegionRects(cairo_image_surface_get_data(image),
+                    cairo_image_surface_get_stride(image),
+                    area.width, area.height, &rects);
+    cairo_surface_destroy(image);
+  }
+
+  cairo_region_t* region = cairo_region_create_rectangles(
+      rects.data(), static_cast<int>(rects.size()));
+  cairo_region_translate(region, area.x, area.y);
+  return region;
+}
+
 }  // namespace
 
 SizeF GetPreferredSizeForWidget(GtkWidget* widget) {
@@ -45,53 +147,27 @@ cairo_region_t* CreateRegionFromSurface(cairo_surface_t* surface) {
   if (cairo_surface_get_content(surface) == CAIRO_CONTENT_COLOR)
     return cairo_region_create_rectangle(&extents);
 
-  cairo_surface_t* image;
-  if (cairo_surface_get_type(surface) != CAIRO_SURFACE_TYPE_IMAGE ||
-      cairo_image_surface_get_format(surface) != CAIRO_FORMAT_A8) {
-    // We work on A8 images to get full alpha channel.
-    image = cairo_image_surface_create(CAIRO_FORMAT_A8,
-                                       extents.width, extents.height);
-    cairo_t* cr = cairo_create(image);
-    cairo_set_source_surface(cr, surface, -extents.x, -extents.y);
-    cairo_paint(cr);
-    cairo_surface_flush(image);
-    cairo_destroy(cr);
-  } else {
-    image = cairo_surface_reference(surface);
-    cairo_surface_flush(image);
-  }
-
-  cairo_region_t* region = cairo_region_create();
-
-  // Iterate through the image.
-  uint8_t* data = cairo_image_surface_get_data(image);
-  int stride = cairo_image_surface_get_stride(image);
-
-  for (int y = 0; y < extents.height; y++) {
-    for (int x = 0; x < extents.width; x++) {
-      // Find a row with all transparent pixels.
-      int ps = x;
-      while (x < extents.width) {
-        // Only full-transparent pixels are treated as transparent, this is
-        // to match the behavior of macOS and Win32.
-        if (data[x] == 0)
-          break;
-        x++;
-      }
-
-      if (x > ps) {
-        // Add the row to region.
-        GdkRectangle rect = {ps, y, x - ps, 1};
-        cairo_region_union_rectangle(region, &rect);
-      }
-    }
+  return CreateRegionFromArea(surface, extents);
+}
 
-    data += stride;
+void UpdateRegionFromSurface(cairo_region_t* region,
+                             cairo_surface_t* surface,
+                             const GdkRectangle& area) {
+  GdkRectangle extents;
+  CairoSurfaceExtents(surface, &extents);
+  GdkRectangle rect;
+  if (!gdk_rectangle_intersect(&extents, &area, &rect))
+    return;
+
+  cairo_region_subtract_rectangle(region, &rect);
+  if (cairo_surface_get_content(surface) == CAIRO_CONTENT_COLOR) {
+    cairo_region_union_rectangle(region, &rect);
+    return;
   }
 
-  cairo_surface_destroy(image);
-  cairo_region_translate(region, extents.x, extents.y);
-  return region;
+  cairo_region_t* damaged = CreateRegionFromArea(surface, rect);
+  cairo_region_union(region, damaged);
+  cairo_region_destroy(damaged);
 }
 
 void ApplyStyle(GtkWidget* widget,
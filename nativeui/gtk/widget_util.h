@@ -22,6 +22,12 @@ SizeF GetPreferredSizeForWidget(NativeView widget);
 // points into the region.
 cairo_region_t* CreateRegionFromSurface(cairo_surface_t* surface);
 
+// Recompute the part of |region| inside |area| from the pixels of |surface|,
+// the parts outside |area| are kept unchanged.
+void UpdateRegionFromSurface(cairo_region_t* region,
+                             cairo_surface_t* surface,
+                             const GdkRectangle& area);
+
 // Apply CSS |style| on |widget|, the style with same |name| will be
 // overwritten.
 void ApplyStyle(GtkWidget* widget,
@@ -0,0 +1,69 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gtk/widget_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+// Fill |rect| of |surface| with |alpha|.
+void FillRect(cairo_surface_t* surface, const GdkRectangle& rect,
+              double alpha) {
+  cairo_t* cr = cairo_create(surface);
+  cairo_set_operator(cr, CAIRO_OPERATOR_SOURCE);
+  cairo_set_source_rgba(cr, 1, 0, 0, alpha);
+  cairo_rectangle(cr, rect.x, rect.y, rect.width, rect.height);
+  cairo_fill(cr);
+  cairo_destroy(cr);
+}
+
+}  // namespace
+
+TEST(WidgetUtilTest, CreateRegionFromSurface) {
+  cairo_surface_t* surface =
+      cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 100, 100);
+  GdkRectangle opaque = {10, 20, 30, 40};
+  FillRect(surface, opaque, 1);
+  GdkRectangle translucent = {60, 20, 1, 1};
+  FillRect(surface, translucent, 0.1);
+
+  cairo_region_t* region = nu::CreateRegionFromSurface(surface);
+  cairo_region_t* expected = cairo_region_create_rectangle(&opaque);
+  cairo_region_union_rectangle(expected, &translucent);
+  EXPECT_TRUE(cairo_region_equal(region, expected));
+  // Identical rows are merged into one rectangle.
+  EXPECT_EQ(cairo_region_num_rectangles(region), 3);
+
+  cairo_region_destroy(expected);
+  cairo_region_destroy(region);
+  cairo_surface_destroy(surface);
+}
+
+TEST(WidgetUtilTest, UpdateRegionFromSurface) {
+  cairo_surface_t* surface =
+      cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 100, 100);
+  GdkRectangle left = {0, 0, 50, 100};
+  FillRect(surface, left, 1);
+  cairo_region_t* region = nu::CreateRegionFromSurface(surface);
+
+  // Move the content to the right half, only the right half is redrawn.
+  FillRect(surface, left, 0);
+  GdkRectangle right = {50, 0, 50, 100};
+  FillRect(surface, right, 1);
+  nu::UpdateRegionFromSurface(region, surface, right);
+
+  cairo_region_t* expected = cairo_region_create_rectangle(&left);
+  cairo_region_union_rectangle(expected, &right);
+  EXPECT_TRUE(cairo_region_equal(region, expected));
+
+  // Redraw the left half.
+  nu::UpdateRegionFromSurface(region, surface, left);
+  cairo_region_destroy(expected);
+  expected = cairo_region_create_rectangle(&right);
+  EXPECT_TRUE(cairo_region_equal(region, expected));
+
+  cairo_region_destroy(expected);
+  cairo_region_destroy(region);
+  cairo_surface_destroy(surface);
+}
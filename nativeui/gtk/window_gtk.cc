@@ -6,6 +6,8 @@
 
 #include <gtk/gtk.h>
 
+#include <cmath>
+
 #include "nativeui/gtk/widget_util.h"
 #include "nativeui/menu_bar.h"
 
@@ -15,6 +17,11 @@ namespace {
 
 // Window private data.
 struct NUWindowPrivate {
+  ~NUWindowPrivate() {
+    if (input_shape)
+      cairo_region_destroy(input_shape);
+  }
+
   Window* delegate = nullptr;
   // Window state.
   int window_state = 0;
@@ -31,6 +38,9 @@ struct NUWindowPrivate {
   bool is_input_shape_set = false;
   bool is_draw_handler_set = false;
   guint draw_handler_id = 0;
+  cairo_region_t* input_shape = nullptr;
+  // Frame clock.
+  guint tick_callback_id = 0;
 };
 
 // Helper to receive private data.
@@ -82,13 +92,39 @@ void OnScreenChanged(GtkWidget* widget, GdkScreen* old_screen, Window* window) {
 // Set input shape for frameless transparent window.
 gboolean OnDraw(GtkWidget* widget, cairo_t* cr, NUWindowPrivate* priv) {
   cairo_surface_t* surface = cairo_get_target(cr);
-  cairo_region_t* region = CreateRegionFromSurface(surface);
-  gtk_widget_input_shape_combine_region(widget, region);
-  cairo_region_destroy(region);
-  // Only handle once.
-  priv->is_draw_handler_set = false;
-  priv->is_input_shape_set = true;
-  g_signal_handler_disconnect(widget, priv->draw_handler_id);
+  if (!priv->is_input_shape_set) {
+    priv->input_shape = CreateRegionFromSurface(surface);
+    priv->is_input_shape_set = true;
+    gtk_widget_input_shape_combine_region(widget, priv->input_shape);
+    return FALSE;
+  }
+
+  // Only recompute the shape in the areas being redrawn.
+  cairo_region_t* old_shape = cairo_region_copy(priv->input_shape);
+  cairo_rectangle_list_t* list = cairo_copy_clip_rectangle_list(cr);
+  if (list->status == CAIRO_STATUS_SUCCESS) {
+    for (int i = 0; i < list->num_rectangles; ++i) {
+      const cairo_rectangle_t& r = list->rectangles[i];
+      int x = std::floor(r.x);
+      int y = std::floor(r.y);
+      GdkRectangle area = {x, y,
+                           static_cast<int>(std::ceil(r.x + r.width)) - x,
+                           static_cast<int>(std::ceil(r.y + r.height)) - y};
+      UpdateRegionFromSurface(priv->input_shape, surface, area);
+    }
+  } else {
+    // The clip is not representable by rectangles, use its extents.
+    GdkRectangle area;
+    if (gdk_cairo_get_clip_rectangle(cr, &area))
+      UpdateRegionFromSurface(priv->input_shape, surface, area);
+  }
+  cairo_rectangle_list_destroy(list);
+
+  // Setting input shape is a round trip to the window system, avoid it when
+  // the shape did not change.
+  if (!cairo_region_equal(old_shape, priv->input_shape))
+    gtk_widget_input_shape_combine_region(widget, priv->input_shape);
+  cairo_region_destroy(old_shape);
   return FALSE;
 }
 
@@ -103,6 +139,27 @@ inline int GetMenuBarHeight(const Window* window) {
   return menu_bar_height;
 }
 
+// Called by GdkFrameClock before painting each frame.
+gboolean OnTick(GtkWidget* widget, GdkFrameClock* clock, gpointer data) {
+  NUWindowPrivate* priv = static_cast<NUWindowPrivate*>(data);
+  // The frame time is in microseconds.
+  double timestamp = gdk_frame_clock_get_frame_time(clock) / 1000.0;
+  if (priv->delegate->TickFrame(timestamp))
+    return G_SOURCE_CONTINUE;
+  priv->tick_callback_id = 0;
+  return G_SOURCE_REMOVE;
+}
+
+void RemoveTickCallback(GtkWindow* window) {
+  NUWindowPrivate* priv = static_cast<NUWindowPrivate*>(
+      g_object_get_data(G_OBJECT(window), "private"));
+  if (priv->tick_callback_id) {
+    gtk_widget_remove_tick_callback(GTK_WIDGET(window),
+                                    priv->tick_callback_id);
+    priv->tick_callback_id = 0;
+  }
+}
+
 }  // namespace
 
 void Window::PlatformInit(const Options& options) {
@@ -144,8 +201,10 @@ void Window::PlatformInit(const Options& options) {
 }
 
 void Window::PlatformDestroy() {
-  if (window_)
+  if (window_) {
+    RemoveTickCallback(window_);
     gtk_widget_destroy(GTK_WIDGET(window_));
+  }
 }
 
 void Window::Close() {
@@ -153,6 +212,8 @@ void Window::Close() {
     return;
 
   on_close.Emit(this);
+  RemoveTickCallback(window_);
+  frame_clock_running_ = false;
   gtk_widget_destroy(GTK_WIDGET(window_));
 
   window_ = nullptr;
@@ -176,9 +237,9 @@ void Window::PlatformSetContentView(View* view) {
   ForceSizeAllocation(window_, GTK_WIDGET(vbox));
 
   // For frameless transparent window, we need to set input shape to allow
-  // click-through in transparent areas. For best performance we only set
-  // input shape the first time when content view is drawn, GTK do redraws very
-  // frequently and computing input shape is rather expensive.
+  // click-through in transparent areas. GTK do redraws very frequently, so
+  // the input shape is computed once when content view is first drawn, and
+  // then only updated in the redrawn areas.
   if (IsTransparent() && !HasFrame()) {
     NUWindowPrivate* priv = GetPrivate(this);
     if (!priv->is_draw_handler_set) {
@@ -343,6 +404,7 @@ bool Window::IsActive() const {
 
 void Window::SetVisible(bool visible) {
   gtk_widget_set_visible(GTK_WIDGET(window_), visible);
+  OnVisibilityChanged();
 }
 
 bool Window::IsVisible() const {
@@ -476,6 +538,16 @@ void Window::SetBackgroundColor(Color color) {
                                        GTK_STATE_FLAG_NORMAL, &gcolor);
 }
 
+void Window::PlatformStartFrameClock() {
+  NUWindowPrivate* priv = GetPrivate(this);
+  priv->tick_callback_id = gtk_widget_add_tick_callback(
+      GTK_WIDGET(window_), OnTick, priv, nullptr);
+}
+
+void Window::PlatformStopFrameClock() {
+  RemoveTickCallback(window_);
+}
+
 void Window::PlatformSetMenuBar(MenuBar* menu_bar) {
   GtkContainer* vbox = GTK_CONTAINER(gtk_bin_get_child(GTK_BIN(window_)));
   if (menu_bar_)
@@ -4,6 +4,11 @@
 
 #include "nativeui/label.h"
 
+#include <cmath>
+
+#include "nativeui/gfx/font.h"
+#include "nativeui/state.h"
+
 namespace nu {
 
 // static
@@ -18,4 +23,39 @@ void Label::SetText(const std::string& text) {
   UpdateDefaultStyle();
 }
 
+void Label::SetWrapping(bool wrap) {
+  if (wrapping_ == wrap)
+    return;
+  wrapping_ = wrap;
+  PlatformSetWrapping(wrap);
+  UpdateDefaultStyle();
+}
+
+SizeF Label::GetMinimumSize() const {
+  return MeasureWithCache(-1);
+}
+
+SizeF Label::Measure(float width) const {
+  // Most labels fit in one line, and the unconstrained size is shared by all
+  // widths that are larger than it.
+  SizeF size = MeasureWithCache(-1);
+  if (!wrapping_ || width < 0 || size.width() <= width)
+    return size;
+  // Round the width so small differences can share the same result.
+  return MeasureWithCache(std::ceil(width));
+}
+
+SizeF Label::MeasureWithCache(float width) const {
+  State* state = State::GetCurrent();
+  Font* font = this->font() ? this->font()
+                            : state->GetApp()->GetDefaultFont();
+  std::string text = GetText();
+  SizeF size;
+  if (!state->text_measure_cache()->Get(font, text, width, &size)) {
+    size = PlatformMeasure(width);
+    state->text_measure_cache()->Put(font, text, width, size);
+  }
+  return size;
+}
+
 }  // namespace nu
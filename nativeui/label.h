@@ -21,15 +21,28 @@ class NATIVEUI_EXPORT Label : public View {
   void SetText(const std::string& text);
   std::string GetText() const;
 
+  // Whether to wrap the text into multiple lines when the label is given less
+  // width than the text needs, off by default.
+  void SetWrapping(bool wrap);
+  bool IsWrapping() const { return wrapping_; }
+
   // View:
   const char* GetClassName() const override;
   SizeF GetMinimumSize() const override;
+  SizeF Measure(float width) const override;
 
  protected:
   ~Label() override;
 
  private:
+  // Measure the text with |width|, looking up the cache first.
+  SizeF MeasureWithCache(float width) const;
+
   void PlatformSetText(const std::string& text);
+  void PlatformSetWrapping(bool wrap);
+  SizeF PlatformMeasure(float width) const;
+
+  bool wrapping_ = false;
 };
 
 }  // namespace nu
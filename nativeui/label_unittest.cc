@@ -32,3 +32,49 @@ TEST_F(LabelTest, UpdateStyle) {
   EXPECT_EQ(height.value, YGNodeStyleGetMinHeight(label_->node()).value);
 }
 #endif
+
+TEST_F(LabelTest, MeasureCache) {
+  nu::TextMeasureCache* cache = state_.text_measure_cache();
+  cache->Clear();
+  label_->SetText("measure");
+  nu::SizeF size = label_->GetMinimumSize();
+  EXPECT_EQ(cache->size(), 1u);
+  scoped_refptr<nu::Label> label2 = new nu::Label("measure");
+  EXPECT_EQ(label2->GetMinimumSize(), size);
+  EXPECT_EQ(cache->size(), 1u);
+  EXPECT_EQ(label_->Measure(size.width() + 10), size);
+  EXPECT_EQ(cache->size(), 1u);
+}
+
+TEST_F(LabelTest, MeasureCacheFontLimit) {
+  nu::TextMeasureCache cache;
+  for (size_t i = 0; i < nu::TextMeasureCache::kMaxFonts + 8; ++i) {
+    scoped_refptr<nu::Font> font = new nu::Font(
+        "Arial", 10.f + i, nu::Font::Weight::Normal, nu::Font::Style::Normal);
+    cache.Put(font.get(), "text", -1, nu::SizeF(10, 10));
+  }
+  EXPECT_EQ(cache.font_count(), nu::TextMeasureCache::kMaxFonts);
+  EXPECT_EQ(cache.size(), nu::TextMeasureCache::kMaxFonts);
+}
+
+TEST_F(LabelTest, HeightForWidth) {
+  label_->SetText("some long text that needs to be wrapped");
+  nu::SizeF size = label_->GetMinimumSize();
+  // Labels do not wrap by default.
+  EXPECT_EQ(label_->Measure(size.width() / 2), size);
+  label_->SetWrapping(true);
+  EXPECT_TRUE(label_->IsWrapping());
+  nu::SizeF wrapped = label_->Measure(size.width() / 2);
+  EXPECT_LE(wrapped.width(), size.width());
+#if !defined(OS_WIN)  // labels on Windows do not wrap
+  EXPECT_GT(wrapped.height(), size.height());
+#endif
+}
+
+TEST_F(LabelTest, CachedMeasurement) {
+  label_->SetText("a");
+  nu::SizeF size = label_->GetCachedMeasurement(-1);
+  EXPECT_EQ(label_->GetCachedMeasurement(-1), size);
+  label_->SetText("a much longer text");
+  EXPECT_GT(label_->GetCachedMeasurement(-1).width(), size.width());
+}
@@ -0,0 +1,169 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <vector>
+
+#include "nativeui/nativeui.h"
+#include "nativeui/test/perf_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+const int kDepth = 200;
+const int kRows = 100;
+const int kColumns = 100;
+const int kChildCount = 1000;
+const int kResizeCount = 100;
+
+}  // namespace
+
+class LayoutPerfTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    window_ = new nu::Window(nu::Window::Options());
+    window_->SetContentSize(nu::SizeF(400, 400));
+    container_ = new nu::Container;
+    window_->SetContentView(container_.get());
+  }
+
+  // Add |rows| rows to the content view, each having |columns| children.
+  void CreateGrid(int rows, int columns) {
+    std::vector<nu::View*> row_views;
+    row_views.reserve(rows);
+    for (int i = 0; i < rows; ++i) {
+      nu::Container* row = new nu::Container;
+      row->SetStyleProperty("flex-direction", "row");
+      row->SetStyleProperty("flex", 1);
+      std::vector<nu::View*> cells;
+      cells.reserve(columns);
+      for (int j = 0; j < columns; ++j) {
+        nu::Container* cell = new nu::Container;
+        cell->SetStyleProperty("flex", 1);
+        cells.push_back(cell);
+      }
+      row->AddChildViews(cells);
+      row_views.push_back(row);
+    }
+    container_->AddChildViews(row_views);
+  }
+
+  // Add |count| children with fixed height to the content view.
+  void CreateChildren(int count) {
+    std::vector<nu::View*> children;
+    children.reserve(count);
+    for (int i = 0; i < count; ++i) {
+      nu::Container* child = new nu::Container;
+      child->SetStyleProperty("height", 10);
+      children.push_back(child);
+    }
+    container_->AddChildViews(children);
+  }
+
+  // Start counting the layout work.
+  void ResetStats() {
+    nu::App::GetCurrent()->ResetLayoutStats();
+  }
+
+  void PrintStats(const std::string& trace, int iterations) {
+    nu::PrintLayoutStats(trace, nu::App::GetCurrent()->GetLayoutStats(),
+                         iterations);
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::Window> window_;
+  scoped_refptr<nu::Container> container_;
+};
+
+TEST_F(LayoutPerfTest, BuildDeepTree) {
+  ResetStats();
+  nu::PerfTimer timer;
+  nu::Container* parent = container_.get();
+  for (int i = 0; i < kDepth; ++i) {
+    nu::Container* child = new nu::Container;
+    child->SetStyleProperty("padding", 1);
+    parent->AddChildView(child);
+    parent = child;
+  }
+  timer.PrintPerOpWithAllocations("layout_build", "deep_tree", kDepth);
+  PrintStats("build_deep_tree", kDepth);
+  EXPECT_EQ(parent->ChildCount(), 0);
+}
+
+TEST_F(LayoutPerfTest, BuildWideTree) {
+  ResetStats();
+  nu::PerfTimer timer;
+  CreateGrid(kRows, kColumns);
+  timer.PrintPerOpWithAllocations("layout_build", "wide_tree",
+                                  kRows * kColumns);
+  PrintStats("build_wide_tree", kRows * kColumns);
+  EXPECT_EQ(container_->ChildCount(), kRows);
+}
+
+TEST_F(LayoutPerfTest, ToggleVisible) {
+  CreateChildren(kChildCount);
+  ResetStats();
+  nu::PerfTimer timer;
+  for (int i = 0; i < kChildCount; ++i)
+    container_->ChildAt(i)->SetVisible(false);
+  for (int i = 0; i < kChildCount; ++i)
+    container_->ChildAt(i)->SetVisible(true);
+  timer.PrintPerOpWithAllocations("layout_set_visible", "toggle",
+                                  kChildCount * 2);
+  PrintStats("set_visible", kChildCount * 2);
+  EXPECT_TRUE(container_->ChildAt(0)->IsVisible());
+}
+
+TEST_F(LayoutPerfTest, SetStyleProperty) {
+  CreateChildren(kChildCount);
+  ResetStats();
+  nu::PerfTimer timer;
+  for (int i = 0; i < kChildCount; ++i) {
+    nu::View* child = container_->ChildAt(i);
+    child->SetStyleProperty("height", 5 + i % 10);
+    child->SetStyleProperty("margin-left", i % 5);
+    child->Layout();
+  }
+  timer.PrintPerOpWithAllocations("layout_set_style", "set_style_property",
+                                  kChildCount);
+  PrintStats("set_style_property", kChildCount);
+}
+
+TEST_F(LayoutPerfTest, ApplyStyleSheet) {
+  CreateChildren(kChildCount);
+  scoped_refptr<nu::StyleSheet> style(new nu::StyleSheet);
+  style->SetProperty("height", 5);
+  style->SetProperty("margin-left", 2);
+  ResetStats();
+  nu::PerfTimer timer;
+  container_->BeginUpdate();
+  for (int i = 0; i < kChildCount; ++i)
+    container_->ChildAt(i)->ApplyStyle(style.get());
+  container_->EndUpdate();
+  timer.PrintPerOpWithAllocations("layout_set_style", "apply_style_sheet",
+                                  kChildCount);
+  PrintStats("apply_style_sheet", kChildCount);
+}
+
+TEST_F(LayoutPerfTest, ResizeRoot) {
+  CreateGrid(kRows / 10, kColumns / 10);
+  ResetStats();
+  nu::PerfTimer timer;
+  for (int i = 0; i < kResizeCount; ++i)
+    window_->SetContentSize(nu::SizeF(400 + i % 2, 400 + i % 3));
+  timer.PrintPerOpWithAllocations("layout_resize", "root", kResizeCount);
+  PrintStats("resize_root", kResizeCount);
+}
+
+TEST_F(LayoutPerfTest, RemoveChildView) {
+  CreateChildren(kChildCount);
+  ResetStats();
+  nu::PerfTimer timer;
+  while (container_->ChildCount() > 0)
+    container_->RemoveChildView(container_->ChildAt(0));
+  timer.PrintPerOpWithAllocations("layout_remove_child", "one_by_one",
+                                  kChildCount);
+  PrintStats("remove_child_view", kChildCount);
+  EXPECT_EQ(container_->ChildCount(), 0);
+}
@@ -0,0 +1,30 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/layout_stats.h"
+
+namespace nu {
+
+LayoutStats::LayoutStats() {}
+
+LayoutStats& LayoutStats::operator+=(const LayoutStats& other) {
+  layout_passes += other.layout_passes;
+  nodes_visited += other.nodes_visited;
+  measure_calls += other.measure_calls;
+  bounds_changes += other.bounds_changes;
+  layout_time += other.layout_time;
+  return *this;
+}
+
+LayoutStats LayoutStats::operator-(const LayoutStats& other) const {
+  LayoutStats result;
+  result.layout_passes = layout_passes - other.layout_passes;
+  result.nodes_visited = nodes_visited - other.nodes_visited;
+  result.measure_calls = measure_calls - other.measure_calls;
+  result.bounds_changes = bounds_changes - other.bounds_changes;
+  result.layout_time = layout_time - other.layout_time;
+  return result;
+}
+
+}  // namespace nu
@@ -0,0 +1,35 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_LAYOUT_STATS_H_
+#define NATIVEUI_LAYOUT_STATS_H_
+
+#include "base/time/time.h"
+#include "nativeui/nativeui_export.h"
+
+namespace nu {
+
+// Counters of the layout work, used for finding views that cause too many
+// layouts.
+struct NATIVEUI_EXPORT LayoutStats {
+  LayoutStats();
+
+  LayoutStats& operator+=(const LayoutStats& other);
+  LayoutStats operator-(const LayoutStats& other) const;
+
+  // How many times the yoga layout was computed.
+  int layout_passes = 0;
+  // Yoga nodes that received new layout.
+  int nodes_visited = 0;
+  // Calls to the measure funcs of leaf views.
+  int measure_calls = 0;
+  // Native views whose bounds were changed by layout.
+  int bounds_changes = 0;
+  // Time spent in YGNodeCalculateLayout.
+  base::TimeDelta layout_time;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_LAYOUT_STATS_H_
@@ -35,12 +35,23 @@ class NATIVEUI_EXPORT Lifetime {
   // Function type for tasks.
   using Task = std::function<void()>;
 
+  // Whether PostTask can be called from other threads. Tasks are posted with
+  // thread timers on Windows, which only fire on the posting thread.
+#if defined(OS_WIN)
+  static const bool kThreadSafePostTask = false;
+#else
+  static const bool kThreadSafePostTask = true;
+#endif
+
   // Control message loop.
   void Run();
   void Quit();
   void PostTask(const Task& task);
   void PostDelayedTask(int ms, const Task& task);
 
+  // Run |task| after pending events are handled but before next redraw.
+  void PostIdleTask(const Task& task);
+
   // Events.
   Signal<void()> on_ready;
 
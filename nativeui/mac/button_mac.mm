@@ -121,6 +121,7 @@ Button::Button(const std::string& title, Type type) {
   [button setTarget:[[NUButtonDelegate alloc] initWithShell:this]];
   [button setAction:@selector(onClick:)];
   TakeOverView(button);
+  UseMeasureFunc();
 
   SetTitle(title);
 }
@@ -34,7 +34,7 @@
   nu::PainterMac painter;
   painter.SetColor(background_color_);
   painter.FillRect(dirty);
-  shell->on_draw.Emit(shell, &painter, dirty);
+  shell->Draw(&painter, dirty);
 }
 
 @end
@@ -56,4 +56,30 @@ void Container::PlatformRemoveChildView(View* child) {
   [child->GetNative() removeFromSuperview];
 }
 
+void Container::PlatformRemoveAllChildViews() {
+  // Removing subviews one by one searches the subviews array for each.
+  [GetNative() setSubviews:@[]];
+}
+
+void Container::PlatformAddChildViews(const std::vector<View*>& views) {
+  NSMutableArray* subviews = [[GetNative() subviews] mutableCopy];
+  for (View* child : views)
+    [subviews addObject:child->GetNative()];
+  [GetNative() setSubviews:subviews];
+  [subviews release];
+}
+
+void Container::PlatformMoveChildView(View* child, int index) {
+  // Subviews are stacked in the order they appear in the array.
+  NSView* native = child->GetNative();
+  [native retain];
+  if (index + 1 < ChildCount())
+    [GetNative() addSubview:native
+                 positioned:NSWindowBelow
+                 relativeTo:ChildAt(index + 1)->GetNative()];
+  else
+    [GetNative() addSubview:native positioned:NSWindowAbove relativeTo:nil];
+  [native release];
+}
+
 }  // namespace nu
@@ -75,6 +75,7 @@ Entry::Entry() {
   [entry setAction:@selector(onActivate:)];
   [entry setDelegate:entry.target];
   TakeOverView(entry);
+  UseMeasureFunc();
   UpdateDefaultStyle();
 }
 
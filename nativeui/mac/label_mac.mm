@@ -74,6 +74,7 @@ namespace nu {
 
 Label::Label(const std::string& text) {
   TakeOverView([[NULabel alloc] init]);
+  UseMeasureFunc();
   SetText(text);
   // Default styles.
   App* app = App::GetCurrent();
@@ -92,8 +93,16 @@ std::string Label::GetText() const {
   return [static_cast<NULabel*>(GetNative()) text];
 }
 
-SizeF Label::GetMinimumSize() const {
-  TextMetrics metrics = MeasureText(GetText(), -1, TextAttributes());
+void Label::PlatformSetWrapping(bool wrap) {
+  // The text is drawn in the bounds of label, which is only narrower than
+  // the text when wrapping.
+}
+
+SizeF Label::PlatformMeasure(float width) const {
+  TextAttributes attributes;
+  if (font())
+    attributes.font = font();
+  TextMetrics metrics = MeasureText(GetText(), width, attributes);
   metrics.size.Enlarge(1, 1);  // leave space for border
   return metrics.size;
 }
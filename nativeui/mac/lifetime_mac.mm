@@ -43,4 +43,15 @@ void Lifetime::PostDelayedTask(int ms, const std::function<void()>& task) {
   });
 }
 
+void Lifetime::PostIdleTask(const std::function<void()>& task) {
+  // Run in common modes so the task also runs during live resizing, the
+  // block is executed before the run loop commits drawing.
+  __block std::function<void()> callback = task;
+  CFRunLoopRef run_loop = CFRunLoopGetMain();
+  CFRunLoopPerformBlock(run_loop, kCFRunLoopCommonModes, ^{
+    callback();
+  });
+  CFRunLoopWakeUp(run_loop);
+}
+
 }  // namespace nu
@@ -5,7 +5,6 @@
 #include "nativeui/state.h"
 
 #include "nativeui/mac/events_handler.h"
-#include "third_party/yoga/yoga/Yoga.h"
 
 namespace nu {
 
@@ -22,8 +21,7 @@ void State::PlatformInit() {
     [[NSUserDefaults standardUserDefaults] registerDefaults:defaults];
   }
 
-  YGConfigSetPointScaleFactor(yoga_config(),
-                              [NSScreen mainScreen].backingScaleFactor);
+  SetYogaScaleFactor([NSScreen mainScreen].backingScaleFactor);
 }
 
 }  // namespace nu
@@ -65,6 +65,8 @@ void View::TakeOverView(NativeView view) {
 
 void View::SetBounds(const RectF& bounds) {
   NSRect frame = bounds.ToCGRect();
+  if (NSEqualRects(frame, [view_ frame]))
+    return;
   [view_ setFrame:frame];
   // Calling setFrame manually does not trigger resizeSubviewsWithOldSize.
   [view_ resizeSubviewsWithOldSize:frame.size];
@@ -84,6 +86,10 @@ RectF View::GetBounds() const {
   return RectF([view_ frame]);
 }
 
+bool View::IsBoundsChangedBy(const RectF& bounds) const {
+  return !NSEqualRects(bounds.ToCGRect(), [view_ frame]);
+}
+
 void View::SetPixelBounds(const Rect& bounds) {
   SetBounds(RectF(bounds));
 }
@@ -96,6 +102,10 @@ void View::SchedulePaint() {
   [view_ setNeedsDisplay:YES];
 }
 
+void View::SchedulePaintRect(const RectF& rect) {
+  [view_ setNeedsDisplayInRect:rect.ToCGRect()];
+}
+
 void View::PlatformSetVisible(bool visible) {
   [view_ setHidden:!visible];
 }
@@ -162,8 +172,7 @@ bool View::IsMouseDownCanMoveWindow() const {
   return [view_ mouseDownCanMoveWindow];
 }
 
-void View::SetFont(Font* font) {
-  font_ = font;
+void View::PlatformSetFont(Font* font) {
   if (IsNUView(view_))
     [view_ setNUFont:font];
 }
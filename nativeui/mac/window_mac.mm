@@ -5,14 +5,18 @@
 #include "nativeui/window.h"
 
 #import <Cocoa/Cocoa.h>
+#include <CoreVideo/CoreVideo.h>
+
+#include <atomic>
 
 #include "base/mac/mac_util.h"
+#include "base/memory/ref_counted.h"
 #include "base/strings/sys_string_conversions.h"
+#include "base/time/time.h"
 #include "nativeui/gfx/mac/coordinate_conversion.h"
 #include "nativeui/mac/nu_private.h"
 #include "nativeui/mac/nu_view.h"
 #include "nativeui/mac/nu_window.h"
-#include "third_party/yoga/yoga/Yoga.h"
 
 #if defined(OS_MACOSX)
 #include "nativeui/toolbar.h"
@@ -45,6 +49,80 @@
 
 namespace nu {
 
+// Drives the frame clock with the refresh of displays. The display link calls
+// back on its own thread, and the ticks are forwarded to the main thread.
+class DisplayLink : public base::RefCountedThreadSafe<DisplayLink> {
+ public:
+  explicit DisplayLink(Window* window) : window_(window) {}
+
+  void Start() {
+    if (!link_) {
+      if (CVDisplayLinkCreateWithActiveCGDisplays(&link_) != kCVReturnSuccess) {
+        link_ = nullptr;
+        return;
+      }
+      CVDisplayLinkSetOutputCallback(link_, &DisplayLink::OnOutput, this);
+    }
+    CVDisplayLinkStart(link_);
+  }
+
+  void Stop() {
+    if (link_)
+      CVDisplayLinkStop(link_);
+  }
+
+  // Called when the window is destroyed.
+  void Detach() {
+    window_ = nullptr;
+    Stop();
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<DisplayLink>;
+
+  ~DisplayLink() {
+    if (link_) {
+      CVDisplayLinkStop(link_);
+      CVDisplayLinkRelease(link_);
+    }
+  }
+
+  static CVReturn OnOutput(CVDisplayLinkRef link,
+                           const CVTimeStamp* now,
+                           const CVTimeStamp* output_time,
+                           CVOptionFlags flags_in,
+                           CVOptionFlags* flags_out,
+                           void* context) {
+    DisplayLink* self = static_cast<DisplayLink*>(context);
+    // Skip the frames while main thread is still handling last one.
+    if (self->tick_pending_.exchange(true))
+      return kCVReturnSuccess;
+    scoped_refptr<DisplayLink> ref(self);
+    dispatch_async(dispatch_get_main_queue(), ^{
+      ref->Tick();
+    });
+    return kCVReturnSuccess;
+  }
+
+  void Tick() {
+    tick_pending_ = false;
+    if (!window_)
+      return;
+    double timestamp =
+        (base::TimeTicks::Now() - base::TimeTicks()).InMillisecondsF();
+    if (!window_->TickFrame(timestamp))
+      Stop();
+  }
+
+  // Only used on main thread.
+  Window* window_;
+
+  CVDisplayLinkRef link_ = nullptr;
+  std::atomic<bool> tick_pending_{false};
+
+  DISALLOW_COPY_AND_ASSIGN(DisplayLink);
+};
+
 void Window::PlatformInit(const Options& options) {
   NSUInteger styleMask = NSTitledWindowMask | NSMiniaturizableWindowMask |
                          NSClosableWindowMask | NSResizableWindowMask |
@@ -60,8 +138,7 @@ void Window::PlatformInit(const Options& options) {
   [window_ setDelegate:[[NUWindowDelegate alloc] initWithShell:this]];
   [window_ setReleasedWhenClosed:NO];
 
-  YGConfigSetPointScaleFactor(yoga_config_,
-                              [window_ screen].backingScaleFactor);
+  SetYogaScaleFactor([window_ screen].backingScaleFactor);
 
   if (!options.frame) {
     // The fullscreen button should always be hidden for frameless window.
@@ -100,6 +177,11 @@ void Window::PlatformInit(const Options& options) {
 }
 
 void Window::PlatformDestroy() {
+  if (display_link_) {
+    display_link_->Detach();
+    display_link_->Release();
+  }
+
   // Clear the delegate class.
   [[window_ delegate] release];
   [window_ setDelegate:nil];
@@ -225,6 +307,20 @@ void Window::SetVisible(bool visible) {
     [window_ orderFrontRegardless];
   else
     [window_ orderOut:nil];
+  OnVisibilityChanged();
+}
+
+void Window::PlatformStartFrameClock() {
+  if (!display_link_) {
+    display_link_ = new DisplayLink(this);
+    display_link_->AddRef();
+  }
+  display_link_->Start();
+}
+
+void Window::PlatformStopFrameClock() {
+  if (display_link_)
+    display_link_->Stop();
 }
 
 bool Window::IsVisible() const {
@@ -19,8 +19,11 @@
 #include "nativeui/gfx/geometry/insets.h"
 #include "nativeui/gfx/image.h"
 #include "nativeui/gfx/painter.h"
+#include "nativeui/gfx/painter_command_buffer.h"
+#include "nativeui/gfx/path.h"
 #include "nativeui/group.h"
 #include "nativeui/label.h"
+#include "nativeui/layout_stats.h"
 #include "nativeui/lifetime.h"
 #include "nativeui/menu.h"
 #include "nativeui/menu_bar.h"
@@ -28,6 +31,7 @@
 #include "nativeui/progress_bar.h"
 #include "nativeui/scroll.h"
 #include "nativeui/state.h"
+#include "nativeui/style_sheet.h"
 #include "nativeui/text_edit.h"
 #include "nativeui/window.h"
 
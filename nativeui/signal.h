@@ -21,6 +21,8 @@ template<typename Sig> class SignalBase {
 
   int Connect(const Slot& slot) {
     slots_.push_back(std::make_pair(++next_id_, slot));
+    if (on_connect_)
+      on_connect_();
     return next_id_;
   }
 
@@ -39,6 +41,12 @@ template<typename Sig> class SignalBase {
     return slots_.empty();
   }
 
+  // Internal: Called after a slot is connected, used by signals that only do
+  // work when someone is listening.
+  void set_on_connect(const std::function<void()>& callback) {
+    on_connect_ = callback;
+  }
+
  protected:
   // Use the first element of tuple as comparing key.
   static bool TupleCompare(const std::pair<int, Slot>& element, int key) {
@@ -47,6 +55,7 @@ template<typename Sig> class SignalBase {
 
   int next_id_ = 0;
   std::vector<std::pair<int, Slot>> slots_;
+  std::function<void()> on_connect_;
 };
 
 template<typename Sig> class Signal;
@@ -4,9 +4,13 @@
 
 #include "nativeui/state.h"
 
+#include <algorithm>
+
 #include "base/lazy_instance.h"
+#include "base/strings/stringprintf.h"
+#include "base/sys_info.h"
+#include "base/threading/thread.h"
 #include "base/threading/thread_local.h"
-#include "third_party/yoga/yoga/Yoga.h"
 
 #if defined(OS_WIN)
 #include "nativeui/gfx/win/native_theme.h"
@@ -15,6 +19,10 @@
 #include "nativeui/win/util/subwin_holder.h"
 #endif
 
+#if defined(OS_LINUX)
+#include "nativeui/gfx/gtk/pango_layout_cache.h"
+#endif
+
 namespace nu {
 
 namespace {
@@ -24,9 +32,13 @@ namespace {
 base::LazyInstance<base::ThreadLocalPointer<State>>::Leaky lazy_tls_ptr =
     LAZY_INSTANCE_INITIALIZER;
 
+// The background work is mostly bound by CPU, more threads than this do not
+// help much.
+const int kMaxWorkerThreads = 4;
+
 }  // namespace
 
-State::State() : yoga_config_(YGConfigNew()) {
+State::State() : yoga_config_(yoga_config_cache_.Acquire(1.f)) {
   DCHECK_EQ(GetCurrent(), nullptr) << "should only have one state per thread";
 
   lazy_tls_ptr.Pointer()->Set(this);
@@ -34,7 +46,12 @@ State::State() : yoga_config_(YGConfigNew()) {
 }
 
 State::~State() {
-  YGConfigFree(yoga_config_);
+  // Wait for the layout in progress, which uses the yoga configs.
+  layout_thread_.reset();
+  // Wait for the background work in progress.
+  worker_threads_.clear();
+
+  yoga_config_cache_.Release(yoga_config_);
 
   DCHECK_EQ(GetCurrent(), this);
   lazy_tls_ptr.Pointer()->Set(nullptr);
@@ -45,4 +62,32 @@ State* State::GetCurrent() {
   return lazy_tls_ptr.Pointer()->Get();
 }
 
+base::Thread* State::GetLayoutThread() {
+  if (!layout_thread_) {
+    layout_thread_.reset(new base::Thread("NativeUILayout"));
+    layout_thread_->Start();
+  }
+  return layout_thread_.get();
+}
+
+base::Thread* State::GetWorkerThread() {
+  size_t max_threads = std::min(base::SysInfo::NumberOfProcessors(),
+                                kMaxWorkerThreads);
+  if (worker_threads_.size() < std::max<size_t>(max_threads, 1)) {
+    base::Thread* thread = new base::Thread(base::StringPrintf(
+        "NativeUIWorker%d", static_cast<int>(worker_threads_.size())));
+    thread->Start();
+    worker_threads_.emplace_back(thread);
+    return thread;
+  }
+  size_t index = next_worker_thread_++ % worker_threads_.size();
+  return worker_threads_[index].get();
+}
+
+void State::SetYogaScaleFactor(float scale_factor) {
+  YGConfigRef config = yoga_config_cache_.Acquire(scale_factor);
+  yoga_config_cache_.Release(yoga_config_);
+  yoga_config_ = config;
+}
+
 }  // namespace nu
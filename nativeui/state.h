@@ -6,11 +6,19 @@
 #define NATIVEUI_STATE_H_
 
 #include <memory>
+#include <vector>
 
 #include "base/memory/ref_counted.h"
 #include "nativeui/app.h"
+#include "nativeui/layout_stats.h"
+#include "nativeui/util/font_registry.h"
+#include "nativeui/util/image_cache.h"
+#include "nativeui/util/text_measure_cache.h"
+#include "nativeui/util/yoga_util.h"
 
-typedef struct YGConfig *YGConfigRef;
+namespace base {
+class Thread;
+}
 
 namespace nu {
 
@@ -21,6 +29,10 @@ class NativeTheme;
 class SubwinHolder;
 #endif
 
+#if defined(OS_LINUX)
+class PangoLayoutCache;
+#endif
+
 class NATIVEUI_EXPORT State {
  public:
   State();
@@ -38,13 +50,44 @@ class NATIVEUI_EXPORT State {
   NativeTheme* GetNativeTheme();
   UINT GetNextCommandID();
 #endif
+#if defined(OS_LINUX)
+  PangoLayoutCache* GetPangoLayoutCache();
+#endif
 
   // Internal: Return the default yoga config.
   YGConfigRef yoga_config() const { return yoga_config_; }
 
+  // Internal: Return the cache of interned yoga configs.
+  YogaConfigCache* yoga_config_cache() { return &yoga_config_cache_; }
+
+  // Internal: Return the cache of measured text sizes.
+  TextMeasureCache* text_measure_cache() { return &text_measure_cache_; }
+
+  // Internal: Return the fonts shared by views.
+  FontRegistry* font_registry() { return &font_registry_; }
+
+  // Internal: Return the cache of images decoded from files.
+  ImageCache* image_cache() { return &image_cache_; }
+
+  // Internal: Return the counters of layout work in all windows.
+  LayoutStats* layout_stats() { return &layout_stats_; }
+
+  // Internal: Return the thread for computing layout, started on first use.
+  // The yoga passes are serialized by a global lock, so all windows share one
+  // thread instead of taking the worker threads.
+  base::Thread* GetLayoutThread();
+
+  // Internal: Return a thread for background work like decoding images and
+  // painting canvases, the threads are started on first use and handed out in
+  // turn.
+  base::Thread* GetWorkerThread();
+
  private:
   void PlatformInit();
 
+  // Change the point scale factor of the default yoga config.
+  void SetYogaScaleFactor(float scale_factor);
+
 #if defined(OS_WIN)
   std::unique_ptr<GdiplusHolder> gdiplus_holder_;
   std::unique_ptr<ClassRegistrar> class_registrar_;
@@ -56,11 +99,35 @@ class NATIVEUI_EXPORT State {
   UINT next_command_id_ = 0x8000;
 #endif
 
+#if defined(OS_LINUX)
+  // Shaped texts shared by painters.
+  std::unique_ptr<PangoLayoutCache> pango_layout_cache_;
+#endif
+
   // The app instance.
   App app_;
 
+  // Yoga configs shared by views and windows.
+  YogaConfigCache yoga_config_cache_;
   YGConfigRef yoga_config_;
 
+  // Sizes of texts measured by labels.
+  TextMeasureCache text_measure_cache_;
+
+  // Images decoded from files.
+  ImageCache image_cache_;
+
+  // Interned fonts.
+  FontRegistry font_registry_;
+
+  // Counters of layout work.
+  LayoutStats layout_stats_;
+
+  std::unique_ptr<base::Thread> layout_thread_;
+
+  std::vector<std::unique_ptr<base::Thread>> worker_threads_;
+  size_t next_worker_thread_ = 0;
+
   DISALLOW_COPY_AND_ASSIGN(State);
 };
 
@@ -0,0 +1,68 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/style_sheet.h"
+
+#include "nativeui/view.h"
+
+namespace nu {
+
+StyleSheet::StyleSheet() {
+}
+
+StyleSheet::~StyleSheet() {
+}
+
+bool StyleSheet::SetProperty(const std::string& name,
+                             const std::string& value) {
+  std::string key(ParseStyleName(name));
+  if (key == "color") {
+    has_color_ = true;
+    color_ = Color(value);
+    return true;
+  } else if (key == "backgroundcolor") {
+    has_background_color_ = true;
+    background_color_ = Color(value);
+    return true;
+  }
+  YogaStyleSetter setter;
+  if (!ParseYogaProperty(key, value, &setter))
+    return false;
+  AddSetter(setter);
+  return true;
+}
+
+bool StyleSheet::SetProperty(const std::string& name, float value) {
+  YogaStyleSetter setter;
+  if (!ParseYogaProperty(ParseStyleName(name), value, &setter))
+    return false;
+  AddSetter(setter);
+  return true;
+}
+
+void StyleSheet::ApplyTo(View* view) const {
+  for (const YogaStyleSetter& setter : setters_)
+    setter.Apply(view->node());
+  if (has_color_)
+    view->SetColor(color_);
+  if (has_background_color_)
+    view->SetBackgroundColor(background_color_);
+}
+
+size_t StyleSheet::size() const {
+  return setters_.size() + (has_color_ ? 1 : 0) +
+         (has_background_color_ ? 1 : 0);
+}
+
+void StyleSheet::AddSetter(const YogaStyleSetter& setter) {
+  for (YogaStyleSetter& s : setters_) {
+    if (s.IsSameProperty(setter)) {
+      s = setter;
+      return;
+    }
+  }
+  setters_.push_back(setter);
+}
+
+}  // namespace nu
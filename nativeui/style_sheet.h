@@ -0,0 +1,55 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_STYLE_SHEET_H_
+#define NATIVEUI_STYLE_SHEET_H_
+
+#include <string>
+#include <vector>
+
+#include "base/memory/ref_counted.h"
+#include "nativeui/gfx/color.h"
+#include "nativeui/util/yoga_util.h"
+
+namespace nu {
+
+class View;
+
+// A set of style properties that are parsed once, and can then be applied to
+// many views without looking up names or parsing values again.
+class NATIVEUI_EXPORT StyleSheet : public base::RefCounted<StyleSheet> {
+ public:
+  StyleSheet();
+
+  // Add a property, a later value of the same property replaces the earlier
+  // one. Return false if the property is unknown or the value is invalid.
+  bool SetProperty(const std::string& name, const std::string& value);
+  bool SetProperty(const std::string& name, float value);
+
+  // Set the styles on |view| without doing layout.
+  void ApplyTo(View* view) const;
+
+  // Return the number of properties.
+  size_t size() const;
+
+ protected:
+  virtual ~StyleSheet();
+
+ private:
+  friend class base::RefCounted<StyleSheet>;
+
+  void AddSetter(const YogaStyleSetter& setter);
+
+  std::vector<YogaStyleSetter> setters_;
+
+  // Styles that are not handled by yoga.
+  bool has_color_ = false;
+  Color color_;
+  bool has_background_color_ = false;
+  Color background_color_;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_STYLE_SHEET_H_
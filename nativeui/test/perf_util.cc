@@ -0,0 +1,125 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/test/perf_util.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include "third_party/yoga/yoga/Yoga.h"
+
+namespace nu {
+
+namespace {
+
+// Every allocation is prefixed with its size.
+const size_t kHeaderSize = 16;
+
+size_t g_yoga_allocated_bytes = 0;
+size_t g_yoga_allocation_count = 0;
+
+void* CountingMalloc(size_t size) {
+  char* ptr = static_cast<char*>(malloc(size + kHeaderSize));
+  if (!ptr)
+    return nullptr;
+  *reinterpret_cast<size_t*>(ptr) = size;
+  g_yoga_allocated_bytes += size;
+  g_yoga_allocation_count++;
+  return ptr + kHeaderSize;
+}
+
+void* CountingCalloc(size_t count, size_t size) {
+  void* ptr = CountingMalloc(count * size);
+  if (ptr)
+    memset(ptr, 0, count * size);
+  return ptr;
+}
+
+void CountingFree(void* ptr) {
+  if (!ptr)
+    return;
+  char* real = static_cast<char*>(ptr) - kHeaderSize;
+  g_yoga_allocated_bytes -= *reinterpret_cast<size_t*>(real);
+  free(real);
+}
+
+void* CountingRealloc(void* ptr, size_t size) {
+  if (!ptr)
+    return CountingMalloc(size);
+  void* result = CountingMalloc(size);
+  if (result) {
+    char* real = static_cast<char*>(ptr) - kHeaderSize;
+    memcpy(result, ptr, std::min(size, *reinterpret_cast<size_t*>(real)));
+    CountingFree(ptr);
+  }
+  return result;
+}
+
+}  // namespace
+
+void InstallYogaAllocationCounter() {
+  YGSetMemoryFuncs(&CountingMalloc, &CountingCalloc, &CountingRealloc,
+                   &CountingFree);
+}
+
+size_t GetYogaAllocatedBytes() {
+  return g_yoga_allocated_bytes;
+}
+
+size_t GetYogaAllocationCount() {
+  return g_yoga_allocation_count;
+}
+
+void PrintPerfResult(const std::string& measurement,
+                     const std::string& trace,
+                     double value,
+                     const std::string& units) {
+  printf("*RESULT %s: %s= %.2f %s\n",
+         measurement.c_str(), trace.c_str(), value, units.c_str());
+  fflush(stdout);
+}
+
+void PrintLayoutStats(const std::string& trace,
+                      const LayoutStats& stats,
+                      int iterations) {
+  double n = std::max(iterations, 1);
+  PrintPerfResult("layout_passes", trace, stats.layout_passes / n, "count/op");
+  PrintPerfResult("layout_nodes_visited", trace, stats.nodes_visited / n,
+                  "count/op");
+  PrintPerfResult("layout_measure_calls", trace, stats.measure_calls / n,
+                  "count/op");
+  PrintPerfResult("layout_bounds_changes", trace, stats.bounds_changes / n,
+                  "count/op");
+}
+
+PerfTimer::PerfTimer()
+    : start_(base::TimeTicks::Now()),
+      start_allocations_(GetYogaAllocationCount()) {
+}
+
+size_t PerfTimer::Allocations() const {
+  return GetYogaAllocationCount() - start_allocations_;
+}
+
+void PerfTimer::PrintPerOp(const std::string& measurement,
+                           const std::string& trace,
+                           int iterations) const {
+  double ns = Elapsed().InMicrosecondsF() * 1000;
+  PrintPerfResult(measurement, trace, ns / std::max(iterations, 1), "ns/op");
+}
+
+void PerfTimer::PrintPerOpWithAllocations(const std::string& measurement,
+                                          const std::string& trace,
+                                          int iterations) const {
+  // Read the allocations first so printing is not counted.
+  double allocations = Allocations();
+  PrintPerOp(measurement, trace, iterations);
+  PrintPerfResult(measurement + "_yoga_allocations", trace,
+                  allocations / std::max(iterations, 1), "allocs/op");
+}
+
+}  // namespace nu
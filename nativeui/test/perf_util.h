@@ -0,0 +1,65 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_TEST_PERF_UTIL_H_
+#define NATIVEUI_TEST_PERF_UTIL_H_
+
+#include <string>
+
+#include "base/time/time.h"
+#include "nativeui/layout_stats.h"
+
+namespace nu {
+
+// Print a result in the "*RESULT measurement: trace= value units" format, which
+// is understood by Chromium's perf tools.
+void PrintPerfResult(const std::string& measurement,
+                     const std::string& trace,
+                     double value,
+                     const std::string& units);
+
+// Route yoga's memory allocations through counting functions, must be called
+// before any yoga node or config is created.
+void InstallYogaAllocationCounter();
+
+// Return the bytes currently allocated by yoga.
+size_t GetYogaAllocatedBytes();
+
+// Return the number of allocations made by yoga since installation.
+size_t GetYogaAllocationCount();
+
+// Print the counters of layout work divided by |iterations|.
+void PrintLayoutStats(const std::string& trace,
+                      const LayoutStats& stats,
+                      int iterations);
+
+// Measure the time elapsed and yoga allocations made since the creation of
+// the timer.
+class PerfTimer {
+ public:
+  PerfTimer();
+
+  base::TimeDelta Elapsed() const { return base::TimeTicks::Now() - start_; }
+
+  // Return the number of yoga allocations since the creation of the timer.
+  size_t Allocations() const;
+
+  // Print the elapsed time divided by |iterations| in ns/op.
+  void PrintPerOp(const std::string& measurement,
+                  const std::string& trace,
+                  int iterations) const;
+
+  // Print both the elapsed time and the yoga allocations per op.
+  void PrintPerOpWithAllocations(const std::string& measurement,
+                                 const std::string& trace,
+                                 int iterations) const;
+
+ private:
+  base::TimeTicks start_;
+  size_t start_allocations_;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_TEST_PERF_UTIL_H_
@@ -27,11 +27,13 @@ typedef struct _GtkWindow GtkWindow;
 typedef struct _PangoFontDescription PangoFontDescription;
 typedef struct _cairo_surface cairo_surface_t;
 typedef struct _cairo cairo_t;
+typedef struct cairo_path cairo_path_t;
 typedef union _GdkEvent GdkEvent;
 #endif
 
 #if defined(OS_MACOSX)
 typedef struct CGContext* CGContextRef;
+typedef struct CGPath* CGMutablePathRef;
 #ifdef __OBJC__
 @class NSBitmapImageRep;
 @class NSEvent;
@@ -72,8 +74,10 @@ class UIWindow;
 #if defined(OS_WIN)
 namespace Gdiplus {
 class Bitmap;
+class BitmapData;
 class Font;
 class Graphics;
+class GraphicsPath;
 class Image;
 }
 #endif
@@ -95,6 +99,7 @@ using NativeView = NSView*;
 using NativeWindow = NSWindow*;
 using NativeBitmap = CGContextRef;
 using NativeImage = NSImage*;
+using NativePath = CGMutablePathRef;
 using nativeGraphicsContext = NSGraphicsContext*;
 using NativeFont = NSFont*;
 using NativeMenu = NSMenu*;
@@ -107,6 +112,7 @@ using NativeView = GtkWidget*;
 using NativeWindow = GtkWindow*;
 using NativeBitmap = cairo_surface_t*;
 using NativeImage = GdkPixbuf*;
+using NativePath = cairo_path_t*;
 using nativeGraphicsContext = cairo_t*;
 using NativeFont = PangoFontDescription*;
 using NativeMenu = GtkMenuShell*;
@@ -120,6 +126,7 @@ using NativeBitmap = Gdiplus::Bitmap*;
 using NativeFont = Gdiplus::Font*;
 using nativeGraphicsContext = Gdiplus::Graphics*;
 using NativeImage = Gdiplus::Image*;
+using NativePath = Gdiplus::GraphicsPath*;
 using NativeMenu = HMENU;
 using NativeMenuItem = MenuItemData*;
 #elif defined(OS_IOS)
@@ -0,0 +1,54 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/util/font_registry.h"
+
+#include <algorithm>
+
+namespace nu {
+
+// static
+const size_t FontRegistry::kMinPurgeThreshold;
+
+FontRegistry::FontRegistry() {
+}
+
+FontRegistry::~FontRegistry() {
+}
+
+Font* FontRegistry::GetDefaultFont() {
+  if (!default_font_)
+    default_font_ = new Font;
+  return default_font_.get();
+}
+
+Font* FontRegistry::GetFont(const std::string& name, float size,
+                            Font::Weight weight, Font::Style style) {
+  Key key(name, size, weight, style);
+  auto it = fonts_.find(key);
+  if (it != fonts_.end())
+    return it->second.get();
+
+  // Apps that keep creating fonts, like animating font sizes, would otherwise
+  // make the registry grow forever.
+  if (fonts_.size() >= purge_threshold_) {
+    Purge();
+    purge_threshold_ = std::max(kMinPurgeThreshold, fonts_.size() * 2);
+  }
+  Font* font = new Font(name, size, weight, style);
+  fonts_[key] = font;
+  return font;
+}
+
+void FontRegistry::Purge() {
+  auto it = fonts_.begin();
+  while (it != fonts_.end()) {
+    if (it->second->HasOneRef())
+      it = fonts_.erase(it);
+    else
+      ++it;
+  }
+}
+
+}  // namespace nu
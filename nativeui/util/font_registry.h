@@ -0,0 +1,57 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_UTIL_FONT_REGISTRY_H_
+#define NATIVEUI_UTIL_FONT_REGISTRY_H_
+
+#include <map>
+#include <string>
+#include <tuple>
+
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "nativeui/gfx/font.h"
+
+namespace nu {
+
+// Interns fonts by their specs, so views using the same font share one native
+// font, and the default font is only created once.
+class NATIVEUI_EXPORT FontRegistry {
+ public:
+  FontRegistry();
+  ~FontRegistry();
+
+  // Return the default GUI font.
+  Font* GetDefaultFont();
+
+  // Return the font with the specs, the same instance is returned for the
+  // same specs.
+  Font* GetFont(const std::string& name, float size, Font::Weight weight,
+                Font::Style style);
+
+  // Forget the fonts that are not used by others. This is done automatically
+  // when the number of fonts doubles since last purge.
+  void Purge();
+
+  // Return the number of interned fonts, not including the default font.
+  size_t size() const { return fonts_.size(); }
+
+ private:
+  using Key = std::tuple<std::string, float, Font::Weight, Font::Style>;
+
+  // Fonts are never purged before there are this many.
+  static const size_t kMinPurgeThreshold = 64;
+
+  scoped_refptr<Font> default_font_;
+  std::map<Key, scoped_refptr<Font>> fonts_;
+
+  // The number of fonts that triggers next purge.
+  size_t purge_threshold_ = kMinPurgeThreshold;
+
+  DISALLOW_COPY_AND_ASSIGN(FontRegistry);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_UTIL_FONT_REGISTRY_H_
@@ -0,0 +1,60 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/util/image_cache.h"
+
+#include "nativeui/gfx/image.h"
+
+namespace nu {
+
+// static
+const size_t ImageCache::kDefaultCapacity;
+
+ImageCache::ImageCache(size_t capacity) : images_(capacity) {
+}
+
+ImageCache::~ImageCache() {
+}
+
+Image* ImageCache::Get(const base::FilePath& path, base::Time mtime) {
+  auto it = images_.Get(GetKey(path, mtime));
+  if (it == images_.end())
+    return nullptr;
+  return it->second.get();
+}
+
+void ImageCache::Put(const base::FilePath& path, base::Time mtime,
+                     Image* image) {
+  images_.Put(GetKey(path, mtime), image);
+}
+
+bool ImageCache::AddRequest(const base::FilePath& path, base::Time mtime,
+                            const Callback& callback) {
+  std::vector<Callback>& callbacks = requests_[GetKey(path, mtime)];
+  callbacks.push_back(callback);
+  return callbacks.size() == 1;
+}
+
+std::vector<ImageCache::Callback> ImageCache::TakeRequests(
+    const base::FilePath& path, base::Time mtime) {
+  std::vector<Callback> callbacks;
+  auto it = requests_.find(GetKey(path, mtime));
+  if (it != requests_.end()) {
+    callbacks.swap(it->second);
+    requests_.erase(it);
+  }
+  return callbacks;
+}
+
+void ImageCache::Clear() {
+  images_.Clear();
+}
+
+// static
+ImageCache::Key ImageCache::GetKey(const base::FilePath& path,
+                                   base::Time mtime) {
+  return Key(path.value(), mtime.ToInternalValue());
+}
+
+}  // namespace nu
@@ -0,0 +1,72 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_UTIL_IMAGE_CACHE_H_
+#define NATIVEUI_UTIL_IMAGE_CACHE_H_
+
+#include <stdint.h>
+
+#include <functional>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "base/containers/mru_cache.h"
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/time/time.h"
+
+namespace nu {
+
+class Image;
+
+// Remembers the images decoded from files, so reading the same file again does
+// not decode it again. An entry is outdated once the file is modified.
+class ImageCache {
+ public:
+  // The default number of images remembered.
+  static const size_t kDefaultCapacity = 64;
+
+  using Callback = std::function<void(Image*)>;
+
+  explicit ImageCache(size_t capacity = kDefaultCapacity);
+  ~ImageCache();
+
+  // Find the image decoded from |path| which was modified at |mtime|.
+  Image* Get(const base::FilePath& path, base::Time mtime);
+
+  // Remember the decoded |image|.
+  void Put(const base::FilePath& path, base::Time mtime, Image* image);
+
+  // Queue |callback| to wait for the image being decoded, return true if it is
+  // the first request of the image, in which case the caller should start
+  // decoding.
+  bool AddRequest(const base::FilePath& path, base::Time mtime,
+                  const Callback& callback);
+
+  // Return and forget the callbacks waiting for the image.
+  std::vector<Callback> TakeRequests(const base::FilePath& path,
+                                     base::Time mtime);
+
+  // Forget all decoded images, the pending requests are kept.
+  void Clear();
+
+  // Return the number of cached images.
+  size_t size() const { return images_.size(); }
+
+ private:
+  using Key = std::pair<base::FilePath::StringType, int64_t>;
+
+  static Key GetKey(const base::FilePath& path, base::Time mtime);
+
+  base::MRUCache<Key, scoped_refptr<Image>> images_;
+  std::map<Key, std::vector<Callback>> requests_;
+
+  DISALLOW_COPY_AND_ASSIGN(ImageCache);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_UTIL_IMAGE_CACHE_H_
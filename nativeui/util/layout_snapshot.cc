@@ -0,0 +1,89 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/util/layout_snapshot.h"
+
+#include <cmath>
+
+#include "nativeui/util/yoga_util.h"
+#include "nativeui/view.h"
+#include "third_party/yoga/yoga/Yoga.h"
+
+namespace nu {
+
+namespace {
+
+YGSize MeasureFromSnapshot(YGNodeRef node,
+                           float width, YGMeasureMode width_mode,
+                           float height, YGMeasureMode height_mode) {
+  auto* m = static_cast<LayoutSnapshot::Measurement*>(YGNodeGetContext(node));
+  SizeF size = m->natural_size;
+  if (width_mode != YGMeasureModeUndefined && width < size.width()) {
+    if (width != m->width)
+      m->missed = true;
+    size = m->size;
+  }
+  // Follow the constraint of height like the measure func of views.
+  if (height_mode == YGMeasureModeExactly ||
+      (height_mode == YGMeasureModeAtMost && size.height() > height))
+    size.set_height(height);
+  return { size.width(), size.height() };
+}
+
+}  // namespace
+
+LayoutSnapshot::LayoutSnapshot(YGNodeRef root,
+                               YGConfigRef config,
+                               const SizeF& size)
+    : root_(CloneYogaTree(root, config)), size_(size) {
+  CollectNodes(root, root_);
+
+  // Measure the views on main thread, views that did not change since last
+  // snapshot return the cached results. The contexts are set after all
+  // measurements are added so the pointers are stable.
+  for (size_t i = 0; i < originals_.size(); ++i) {
+    YGNodeRef original = originals_[i];
+    if (!YGNodeGetMeasureFunc(original))
+      continue;
+    View* view = static_cast<View*>(YGNodeGetContext(original));
+    Measurement m = { i, YGNodeLayoutGetWidth(original) };
+    m.natural_size = view->GetCachedMeasurement(-1);
+    if (std::isnan(m.width) || m.width <= 0)
+      m.size = m.natural_size;
+    else
+      m.size = view->GetCachedMeasurement(m.width);
+    m.missed = false;
+    measurements_.push_back(m);
+  }
+  for (Measurement& m : measurements_) {
+    YGNodeSetContext(nodes_[m.index], &m);
+    YGNodeSetMeasureFunc(nodes_[m.index], MeasureFromSnapshot);
+  }
+}
+
+LayoutSnapshot::~LayoutSnapshot() {
+  if (root_)
+    FreeYogaTree(root_);
+}
+
+void LayoutSnapshot::Calculate() {
+  base::TimeTicks start = base::TimeTicks::Now();
+  CalculateYogaLayout(root_, size_.width(), size_.height());
+  layout_time_ = base::TimeTicks::Now() - start;
+}
+
+YGNodeRef LayoutSnapshot::ReleaseTree() {
+  YGNodeRef root = root_;
+  root_ = nullptr;
+  return root;
+}
+
+void LayoutSnapshot::CollectNodes(YGNodeRef original, YGNodeRef node) {
+  originals_.push_back(original);
+  nodes_.push_back(node);
+  for (uint32_t i = 0; i < YGNodeGetChildCount(original); ++i)
+    CollectNodes(YGNodeGetChild(original, i), YGNodeGetChild(node, i));
+}
+
+}  // namespace nu
@@ -0,0 +1,81 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_UTIL_LAYOUT_SNAPSHOT_H_
+#define NATIVEUI_UTIL_LAYOUT_SNAPSHOT_H_
+
+#include <vector>
+
+#include "base/memory/ref_counted.h"
+#include "base/time/time.h"
+#include "nativeui/gfx/geometry/size_f.h"
+
+typedef struct YGNode *YGNodeRef;
+typedef struct YGConfig *YGConfigRef;
+
+namespace nu {
+
+// A copy of a yoga tree whose layout can be computed on other threads.
+//
+// The measure funcs of views are not thread-safe, so the leaf views are
+// measured when taking the snapshot, and the measure funcs of the copy only
+// return the recorded sizes. When yoga asks for a width that was not recorded
+// the measurement is marked as missed, and the node should be measured again
+// on the main thread.
+class LayoutSnapshot : public base::RefCountedThreadSafe<LayoutSnapshot> {
+ public:
+  // Recorded sizes of a leaf view.
+  struct Measurement {
+    // Index of the node in pre-order.
+    size_t index;
+    // The width of the view in last layout, and the size measured for it.
+    float width;
+    SizeF size;
+    // The size measured without constraint.
+    SizeF natural_size;
+    // Whether yoga asked for a size that was not recorded.
+    bool missed;
+  };
+
+  // Copy the tree of |root|, must be called on the main thread.
+  LayoutSnapshot(YGNodeRef root, YGConfigRef config, const SizeF& size);
+
+  // Compute the layout of the copied tree, can be called on any thread.
+  void Calculate();
+
+  // Take the ownership of the copied tree.
+  YGNodeRef ReleaseTree();
+
+  // The original nodes and the copied ones, in pre-order.
+  const std::vector<YGNodeRef>& originals() const { return originals_; }
+  const std::vector<YGNodeRef>& nodes() const { return nodes_; }
+
+  // The recorded sizes of leaf views.
+  const std::vector<Measurement>& measurements() const {
+    return measurements_;
+  }
+
+  // Time spent on computing the layout.
+  base::TimeDelta layout_time() const { return layout_time_; }
+
+ private:
+  friend class base::RefCountedThreadSafe<LayoutSnapshot>;
+
+  ~LayoutSnapshot();
+
+  void CollectNodes(YGNodeRef original, YGNodeRef node);
+
+  YGNodeRef root_;
+  SizeF size_;
+  std::vector<YGNodeRef> originals_;
+  std::vector<YGNodeRef> nodes_;
+  std::vector<Measurement> measurements_;
+  base::TimeDelta layout_time_;
+
+  DISALLOW_COPY_AND_ASSIGN(LayoutSnapshot);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_UTIL_LAYOUT_SNAPSHOT_H_
@@ -0,0 +1,82 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/util/text_measure_cache.h"
+
+#include "base/strings/stringprintf.h"
+#include "nativeui/gfx/font.h"
+
+namespace nu {
+
+namespace {
+
+// Fonts are compared by their descriptions, since the same font can be created
+// more than once.
+std::string GetFontKey(Font* font) {
+  return base::StringPrintf("%s:%f:%d:%d", font->GetName().c_str(),
+                            font->GetSize(),
+                            static_cast<int>(font->GetWeight()),
+                            static_cast<int>(font->GetStyle()));
+}
+
+// All negative widths mean the same thing.
+inline float NormalizeWidth(float width) {
+  return width < 0 ? -1.f : width;
+}
+
+}  // namespace
+
+// static
+const size_t TextMeasureCache::kDefaultCapacity;
+const size_t TextMeasureCache::kMaxFonts;
+
+TextMeasureCache::TextMeasureCache(size_t capacity)
+    : capacity_(capacity), fonts_(kMaxFonts) {
+}
+
+TextMeasureCache::~TextMeasureCache() {
+}
+
+bool TextMeasureCache::Get(Font* font, const std::string& text, float width,
+                           SizeF* size) {
+  Entries* entries = GetEntries(font, false);
+  if (!entries)
+    return false;
+  auto it = entries->Get(Key(text, NormalizeWidth(width)));
+  if (it == entries->end())
+    return false;
+  *size = it->second;
+  return true;
+}
+
+void TextMeasureCache::Put(Font* font, const std::string& text, float width,
+                           const SizeF& size) {
+  GetEntries(font, true)->Put(Key(text, NormalizeWidth(width)), size);
+}
+
+void TextMeasureCache::Clear() {
+  fonts_.Clear();
+}
+
+size_t TextMeasureCache::size() const {
+  size_t count = 0;
+  for (const auto& it : fonts_)
+    count += it.second->size();
+  return count;
+}
+
+TextMeasureCache::Entries* TextMeasureCache::GetEntries(Font* font,
+                                                        bool create) {
+  std::string key = GetFontKey(font);
+  auto it = fonts_.Get(key);
+  if (it != fonts_.end())
+    return it->second.get();
+  if (!create)
+    return nullptr;
+  Entries* entries = new Entries(capacity_);
+  fonts_.Put(key, std::unique_ptr<Entries>(entries));
+  return entries;
+}
+
+}  // namespace nu
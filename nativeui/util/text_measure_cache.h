@@ -0,0 +1,65 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_UTIL_TEXT_MEASURE_CACHE_H_
+#define NATIVEUI_UTIL_TEXT_MEASURE_CACHE_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+#include "nativeui/gfx/geometry/size_f.h"
+
+namespace nu {
+
+class Font;
+
+// Remembers the measured sizes of strings, each font has its own LRU list so
+// rarely used fonts do not evict the texts of commonly used ones. The fonts
+// are also kept in a LRU list, so the lists of unused fonts are dropped.
+class TextMeasureCache {
+ public:
+  // The default number of strings remembered for each font.
+  static const size_t kDefaultCapacity = 256;
+
+  // The number of fonts whose strings are remembered.
+  static const size_t kMaxFonts = 32;
+
+  explicit TextMeasureCache(size_t capacity = kDefaultCapacity);
+  ~TextMeasureCache();
+
+  // Find the size of |text| measured with |font| in |width|, returns false if
+  // it has not been measured. A negative |width| means no constraint.
+  bool Get(Font* font, const std::string& text, float width, SizeF* size);
+
+  // Remember the measured size of |text|.
+  void Put(Font* font, const std::string& text, float width,
+           const SizeF& size);
+
+  // Forget all measured sizes.
+  void Clear();
+
+  // Return the number of cached strings of all fonts.
+  size_t size() const;
+
+  // Return the number of fonts that have cached strings.
+  size_t font_count() const { return fonts_.size(); }
+
+ private:
+  using Key = std::pair<std::string, float>;
+  using Entries = base::MRUCache<Key, SizeF>;
+
+  Entries* GetEntries(Font* font, bool create);
+
+  size_t capacity_;
+  base::HashingMRUCache<std::string, std::unique_ptr<Entries>> fonts_;
+
+  DISALLOW_COPY_AND_ASSIGN(TextMeasureCache);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_UTIL_TEXT_MEASURE_CACHE_H_
@@ -0,0 +1,85 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/util/tile_cache.h"
+
+#include <math.h>
+
+#include "nativeui/gfx/canvas.h"
+
+namespace nu {
+
+// static
+const int TileCache::kTileSize;
+const size_t TileCache::kDefaultMemoryLimit;
+
+TileCache::TileCache(size_t memory_limit)
+    : tiles_(Tiles::NO_AUTO_EVICT), memory_limit_(memory_limit) {
+}
+
+TileCache::~TileCache() {
+}
+
+// static
+RectF TileCache::GetTileRect(int column, int row) {
+  return RectF(column * kTileSize, row * kTileSize, kTileSize, kTileSize);
+}
+
+Canvas* TileCache::Get(int column, int row) {
+  auto it = tiles_.Get(Key(column, row));
+  if (it == tiles_.end())
+    return nullptr;
+  return it->second.get();
+}
+
+void TileCache::Put(int column, int row, Canvas* tile) {
+  auto it = tiles_.Peek(Key(column, row));
+  if (it != tiles_.end()) {
+    memory_usage_ -= GetTileMemory(it->second.get());
+    tiles_.Erase(it);
+  }
+  tiles_.Put(Key(column, row), tile);
+  memory_usage_ += GetTileMemory(tile);
+  Shrink();
+}
+
+void TileCache::Invalidate(const RectF& rect) {
+  auto it = tiles_.begin();
+  while (it != tiles_.end()) {
+    if (GetTileRect(it->first.first, it->first.second).Intersects(rect)) {
+      memory_usage_ -= GetTileMemory(it->second.get());
+      it = tiles_.Erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void TileCache::Clear() {
+  tiles_.Clear();
+  memory_usage_ = 0;
+}
+
+void TileCache::SetMemoryLimit(size_t bytes) {
+  memory_limit_ = bytes;
+  Shrink();
+}
+
+// static
+size_t TileCache::GetTileMemory(Canvas* tile) {
+  float scale_factor = tile->GetScaleFactor();
+  SizeF size = tile->GetSize();
+  return static_cast<size_t>(ceil(size.width() * scale_factor) *
+                             ceil(size.height() * scale_factor)) * 4;
+}
+
+void TileCache::Shrink() {
+  while (memory_usage_ > memory_limit_ && !tiles_.empty()) {
+    auto it = tiles_.rbegin();
+    memory_usage_ -= GetTileMemory(it->second.get());
+    tiles_.Erase(it);
+  }
+}
+
+}  // namespace nu
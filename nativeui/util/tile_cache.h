@@ -0,0 +1,75 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_UTIL_TILE_CACHE_H_
+#define NATIVEUI_UTIL_TILE_CACHE_H_
+
+#include <utility>
+
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "nativeui/gfx/geometry/rect_f.h"
+
+namespace nu {
+
+class Canvas;
+
+// Remembers the rendered content of a view in fixed-size tiles, the least
+// recently used tiles are forgotten when they take more memory than the limit.
+class TileCache {
+ public:
+  // The width and height of each tile in DIPs.
+  static const int kTileSize = 256;
+
+  // The default maximum bytes of memory used by tiles.
+  static const size_t kDefaultMemoryLimit = 64 * 1024 * 1024;
+
+  explicit TileCache(size_t memory_limit = kDefaultMemoryLimit);
+  ~TileCache();
+
+  // Return the area covered by the tile at |column| and |row|.
+  static RectF GetTileRect(int column, int row);
+
+  // Find the tile at |column| and |row|.
+  Canvas* Get(int column, int row);
+
+  // Remember the rendered |tile|.
+  void Put(int column, int row, Canvas* tile);
+
+  // Forget the tiles that intersect |rect|.
+  void Invalidate(const RectF& rect);
+
+  // Forget all tiles.
+  void Clear();
+
+  // Change the memory limit, tiles are forgotten if they exceed the limit.
+  void SetMemoryLimit(size_t bytes);
+  size_t memory_limit() const { return memory_limit_; }
+
+  // Return the bytes of memory used by tiles.
+  size_t memory_usage() const { return memory_usage_; }
+
+  // Return the number of cached tiles.
+  size_t size() const { return tiles_.size(); }
+
+ private:
+  using Key = std::pair<int, int>;
+  using Tiles = base::MRUCache<Key, scoped_refptr<Canvas>>;
+
+  static size_t GetTileMemory(Canvas* tile);
+
+  // Forget the least recently used tiles until the memory is under limit.
+  void Shrink();
+
+  Tiles tiles_;
+  size_t memory_limit_;
+  size_t memory_usage_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(TileCache);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_UTIL_TILE_CACHE_H_
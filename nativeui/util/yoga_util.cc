@@ -8,14 +8,20 @@
 #include <tuple>
 #include <utility>
 
+#include "base/lazy_instance.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
+#include "base/synchronization/lock.h"
 #include "third_party/yoga/yoga/Yoga.h"
 
 namespace nu {
 
 namespace {
 
+// Guards the global states of yoga when computing layout.
+base::LazyInstance<base::Lock>::Leaky g_layout_lock =
+    LAZY_INSTANCE_INITIALIZER;
+
 // Converters to convert string to integer.
 using IntConverter = bool(*)(const std::string&, int*);
 
@@ -329,10 +335,10 @@ T* Find(T (&setters)[n], const std::string& name) {
   return &(*iter);
 }
 
-// Set style for int properties.
-bool SetIntStyle(YGNodeRef node,
-                 const std::string& name,
-                 const std::string& value) {
+// Parse int properties.
+bool ParseIntStyle(const std::string& name,
+                   const std::string& value,
+                   YogaStyleSetter* out) {
   auto* tup = Find(int_setters, name);
   if (!tup)
     return false;
@@ -341,59 +347,77 @@ bool SetIntStyle(YGNodeRef node,
     LOG(WARNING) << "Invalid value " << value << " for property " << name;
     return false;
   }
-  std::get<2>(*tup)(node, converted);
+  out->type = YogaStyleSetter::Type::Int;
+  out->int_setter = std::get<2>(*tup);
+  out->int_value = converted;
   return true;
 }
 
-// Set style for float properties.
-bool SetFloatStyle(YGNodeRef node, const std::string& name, float value) {
+// Parse float properties.
+bool ParseFloatStyle(const std::string& name,
+                     float value,
+                     YogaStyleSetter* out) {
   auto* tup = Find(float_setters, name);
   if (!tup)
     return false;
-  std::get<1>(*tup)(node, value);
+  out->type = YogaStyleSetter::Type::Float;
+  out->float_setter = std::get<1>(*tup);
+  out->float_value = value;
   return true;
 }
 
-bool SetFloatStyle(YGNodeRef node,
-                   const std::string& name,
-                   const std::string& value) {
-  return SetFloatStyle(node, name, PixelValue(value));
+bool ParseFloatStyle(const std::string& name,
+                     const std::string& value,
+                     YogaStyleSetter* out) {
+  return ParseFloatStyle(name, PixelValue(value), out);
 }
 
-// Set style for percent properties.
-bool SetPercentStyle(YGNodeRef node,
-                     const std::string& name,
-                     const std::string& value) {
+// Parse percent properties.
+bool ParsePercentStyle(const std::string& name,
+                       const std::string& value,
+                       YogaStyleSetter* out) {
   auto* tup = Find(percent_setters, name);
   if (!tup)
     return false;
-  std::get<1>(*tup)(node, PercentValue(value));
+  out->type = YogaStyleSetter::Type::Float;
+  out->float_setter = std::get<1>(*tup);
+  out->float_value = PercentValue(value);
   return true;
 }
 
-// Set style for edge properties.
-bool SetEdgeStyle(YGNodeRef node, const std::string& name, float value) {
+// Parse edge properties.
+bool ParseEdgeStyle(const std::string& name,
+                    float value,
+                    YogaStyleSetter* out) {
   auto* tup = Find(edge_setters, name);
   if (!tup)
     return false;
-  std::get<2>(*tup)(node, std::get<1>(*tup), value);
+  out->type = YogaStyleSetter::Type::Edge;
+  out->edge_setter =
+      reinterpret_cast<YogaStyleSetter::EdgeSetter>(std::get<2>(*tup));
+  out->edge = std::get<1>(*tup);
+  out->float_value = value;
   return true;
 }
 
-bool SetEdgeStyle(YGNodeRef node,
-                  const std::string& name,
-                  const std::string& value) {
-  return SetEdgeStyle(node, name, PixelValue(value));
+bool ParseEdgeStyle(const std::string& name,
+                    const std::string& value,
+                    YogaStyleSetter* out) {
+  return ParseEdgeStyle(name, PixelValue(value), out);
 }
 
-// Set style for edge percent properties.
-bool SetEdgePercentStyle(YGNodeRef node,
-                         const std::string& name,
-                         const std::string& value) {
+// Parse edge percent properties.
+bool ParseEdgePercentStyle(const std::string& name,
+                           const std::string& value,
+                           YogaStyleSetter* out) {
   auto* tup = Find(edge_percent_setters, name);
   if (!tup)
     return false;
-  std::get<2>(*tup)(node, std::get<1>(*tup), PercentValue(value));
+  out->type = YogaStyleSetter::Type::Edge;
+  out->edge_setter =
+      reinterpret_cast<YogaStyleSetter::EdgeSetter>(std::get<2>(*tup));
+  out->edge = std::get<1>(*tup);
+  out->float_value = PercentValue(value);
   return true;
 }
 
@@ -406,27 +430,148 @@ bool IsPercentValue(const std::string& value) {
 
 }  // namespace
 
-void SetYogaProperty(YGNodeRef node, const std::string& name, float value) {
-  SetFloatStyle(node, name, value) ||
-  SetEdgeStyle(node, name, value);
+YogaConfigCache::YogaConfigCache() {
 }
 
-void SetYogaProperty(YGNodeRef node,
-                     const std::string& name,
-                     const std::string& value) {
+YogaConfigCache::~YogaConfigCache() {
+  for (const Entry& entry : entries_)
+    YGConfigFree(entry.config);
+}
+
+YGConfigRef YogaConfigCache::Acquire(float scale_factor) {
+  for (Entry& entry : entries_) {
+    if (entry.scale_factor == scale_factor) {
+      entry.ref_count++;
+      return entry.config;
+    }
+  }
+  YGConfigRef config = YGConfigNew();
+  YGConfigSetPointScaleFactor(config, scale_factor);
+  entries_.push_back({scale_factor, config, 1});
+  return config;
+}
+
+void YogaConfigCache::AddRef(YGConfigRef config) {
+  auto it = Find(config);
+  DCHECK(it != entries_.end()) << "The config is not interned";
+  if (it != entries_.end())
+    it->ref_count++;
+}
+
+void YogaConfigCache::Release(YGConfigRef config) {
+  auto it = Find(config);
+  DCHECK(it != entries_.end()) << "The config is not interned";
+  if (it == entries_.end() || --it->ref_count > 0)
+    return;
+  YGConfigFree(it->config);
+  entries_.erase(it);
+}
+
+std::vector<YogaConfigCache::Entry>::iterator YogaConfigCache::Find(
+    YGConfigRef config) {
+  return std::find_if(entries_.begin(), entries_.end(),
+                      [config](const Entry& e) { return e.config == config; });
+}
+
+void CalculateYogaLayout(YGNodeRef node, float width, float height) {
+  base::AutoLock auto_lock(g_layout_lock.Get());
+  YGNodeCalculateLayout(node, width, height, YGDirectionLTR);
+}
+
+YGNodeRef CloneYogaTree(YGNodeRef node, YGConfigRef config) {
+  YGNodeRef clone = YGNodeNewWithConfig(config);
+  YGNodeCopyStyle(clone, node);
+  YGNodeSetContext(clone, YGNodeGetContext(node));
+  YGNodeSetMeasureFunc(clone, YGNodeGetMeasureFunc(node));
+  for (uint32_t i = 0; i < YGNodeGetChildCount(node); ++i)
+    YGNodeInsertChild(clone, CloneYogaTree(YGNodeGetChild(node, i), config), i);
+  return clone;
+}
+
+void FreeYogaTree(YGNodeRef node) {
+  while (YGNodeGetChildCount(node) > 0) {
+    YGNodeRef child = YGNodeGetChild(node, YGNodeGetChildCount(node) - 1);
+    YGNodeRemoveChild(node, child);
+    FreeYogaTree(child);
+  }
+  YGNodeFree(node);
+}
+
+std::string ParseStyleName(const std::string& name) {
+  std::string parsed;
+  parsed.reserve(name.size());
+  for (char c : name) {
+    if (base::IsAsciiAlpha(c))
+      parsed.push_back(base::ToLowerASCII(c));
+  }
+  return parsed;
+}
+
+bool YogaStyleSetter::IsSameProperty(const YogaStyleSetter& other) const {
+  if (type != other.type)
+    return false;
+  switch (type) {
+    case Type::Int:
+      return int_setter == other.int_setter;
+    case Type::Float:
+      return float_setter == other.float_setter;
+    case Type::Edge:
+      return edge_setter == other.edge_setter && edge == other.edge;
+  }
+  return false;
+}
+
+void YogaStyleSetter::Apply(YGNodeRef node) const {
+  switch (type) {
+    case Type::Int:
+      int_setter(node, int_value);
+      break;
+    case Type::Float:
+      float_setter(node, float_value);
+      break;
+    case Type::Edge:
+      edge_setter(node, edge, float_value);
+      break;
+  }
+}
+
+bool ParseYogaProperty(const std::string& name,
+                       float value,
+                       YogaStyleSetter* out) {
+  return ParseFloatStyle(name, value, out) ||
+         ParseEdgeStyle(name, value, out);
+}
+
+bool ParseYogaProperty(const std::string& name,
+                       const std::string& value,
+                       YogaStyleSetter* out) {
   DCHECK(IsSorted(int_setters) &&
          IsSorted(float_setters) &&
          IsSorted(percent_setters) &&
          IsSorted(edge_setters) &&
          IsSorted(edge_percent_setters))<< "Property setters must be sorted";
   if (IsPercentValue(value)) {
-    SetPercentStyle(node, name, value) ||
-    SetEdgePercentStyle(node, name, value);
+    return ParsePercentStyle(name, value, out) ||
+           ParseEdgePercentStyle(name, value, out);
   } else {
-    SetIntStyle(node, name, value) ||
-    SetFloatStyle(node, name, value) ||
-    SetEdgeStyle(node, name, value);
+    return ParseIntStyle(name, value, out) ||
+           ParseFloatStyle(name, value, out) ||
+           ParseEdgeStyle(name, value, out);
   }
 }
 
+void SetYogaProperty(YGNodeRef node, const std::string& name, float value) {
+  YogaStyleSetter setter;
+  if (ParseYogaProperty(name, value, &setter))
+    setter.Apply(node);
+}
+
+void SetYogaProperty(YGNodeRef node,
+                     const std::string& name,
+                     const std::string& value) {
+  YogaStyleSetter setter;
+  if (ParseYogaProperty(name, value, &setter))
+    setter.Apply(node);
+}
+
 }  // namespace nu
@@ -6,11 +6,103 @@
 #define NATIVEUI_UTIL_YOGA_UTIL_H_
 
 #include <string>
+#include <vector>
+
+#include "base/macros.h"
 
 typedef struct YGNode *YGNodeRef;
+typedef struct YGConfig *YGConfigRef;
 
 namespace nu {
 
+// Interns yoga configs by their contents, so views with identical configs
+// share one YGConfigRef instead of each owning a copy.
+class YogaConfigCache {
+ public:
+  YogaConfigCache();
+  ~YogaConfigCache();
+
+  // Return a config with |scale_factor| as point scale factor, the returned
+  // config is referenced and must be released by calling Release.
+  YGConfigRef Acquire(float scale_factor);
+
+  // Reference counting of interned configs.
+  void AddRef(YGConfigRef config);
+  void Release(YGConfigRef config);
+
+  // Return the number of interned configs.
+  size_t size() const { return entries_.size(); }
+
+ private:
+  struct Entry {
+    float scale_factor;
+    YGConfigRef config;
+    int ref_count;
+  };
+
+  std::vector<Entry>::iterator Find(YGConfigRef config);
+
+  // There are usually only one or two configs, so a vector is good enough.
+  std::vector<Entry> entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(YogaConfigCache);
+};
+
+// Compute the layout of |node|, can be called on any thread as long as the
+// tree is not touched by other threads. The calls are serialized since yoga
+// keeps global states like the generation and depth counters when computing
+// layout.
+void CalculateYogaLayout(YGNodeRef node, float width, float height);
+
+// Create a detached copy of the yoga tree with styles and measure funcs, the
+// copy must be freed with FreeYogaTree.
+YGNodeRef CloneYogaTree(YGNodeRef node, YGConfigRef config);
+void FreeYogaTree(YGNodeRef node);
+
+// Convert the style name to lower case and remove non-alphabet characters.
+std::string ParseStyleName(const std::string& name);
+
+// A yoga property with its setter resolved and value parsed, so it can be
+// applied to nodes without looking up names or parsing strings again.
+struct YogaStyleSetter {
+  enum class Type {
+    Int,
+    Float,
+    Edge,
+  };
+
+  using IntSetter = void(*)(YGNodeRef, int);
+  using FloatSetter = void(*)(YGNodeRef, float);
+  using EdgeSetter = void(*)(YGNodeRef, int, float);
+
+  // Whether the two setters change the same property.
+  bool IsSameProperty(const YogaStyleSetter& other) const;
+
+  // Set the property on |node|.
+  void Apply(YGNodeRef node) const;
+
+  Type type;
+  union {
+    IntSetter int_setter;
+    FloatSetter float_setter;
+    EdgeSetter edge_setter;
+  };
+  int edge;
+  union {
+    int int_value;
+    float float_value;
+  };
+};
+
+// Parse the property, |key| must be lower case without dashes. Return false
+// if the property is unknown or the value is invalid.
+bool ParseYogaProperty(const std::string& key,
+                       float value,
+                       YogaStyleSetter* out);
+bool ParseYogaProperty(const std::string& key,
+                       const std::string& value,
+                       YogaStyleSetter* out);
+
 void SetYogaProperty(YGNodeRef node, const std::string& key, float value);
 void SetYogaProperty(YGNodeRef node,
                      const std::string& key,
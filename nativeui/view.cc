@@ -4,10 +4,13 @@
 
 #include "nativeui/view.h"
 
-#include "base/strings/string_util.h"
+#include <vector>
+
+#include "base/strings/stringprintf.h"
 #include "nativeui/container.h"
 #include "nativeui/gfx/font.h"
 #include "nativeui/state.h"
+#include "nativeui/style_sheet.h"
 #include "nativeui/util/yoga_util.h"
 #include "nativeui/window.h"
 #include "third_party/yoga/yoga/Yoga.h"
@@ -16,15 +19,36 @@ namespace nu {
 
 namespace {
 
-// Convert case to lower and remove non-ASCII characters.
-std::string ParseName(const std::string& name) {
-  std::string parsed;
-  parsed.reserve(name.size());
-  for (char c : name) {
-    if (base::IsAsciiAlpha(c))
-      parsed.push_back(base::ToLowerASCII(c));
-  }
-  return parsed;
+// Forward yoga's measurement to the view.
+YGSize MeasureView(YGNodeRef node,
+                   float width, YGMeasureMode width_mode,
+                   float height, YGMeasureMode height_mode) {
+  State::GetCurrent()->layout_stats()->measure_calls++;
+  View* view = static_cast<View*>(YGNodeGetContext(node));
+  SizeF size = view->Measure(width_mode == YGMeasureModeUndefined ? -1 : width);
+  // Measure only knows about width, the height is constrained here.
+  if (height_mode == YGMeasureModeExactly ||
+      (height_mode == YGMeasureModeAtMost && size.height() > height))
+    size.set_height(height);
+  return { size.width(), size.height() };
+}
+
+void DumpYogaNode(YGNodeRef node, int depth, std::string* out) {
+  View* view = static_cast<View*>(YGNodeGetContext(node));
+  out->append(2 * depth, ' ');
+  base::StringAppendF(out, "%s (%g, %g, %g, %g)",
+                      view ? view->GetClassName() : "?",
+                      YGNodeLayoutGetLeft(node), YGNodeLayoutGetTop(node),
+                      YGNodeLayoutGetWidth(node), YGNodeLayoutGetHeight(node));
+  if (view && !view->IsVisible())
+    out->append(" hidden");
+  if (YGNodeGetMeasureFunc(node))
+    out->append(" measured");
+  if (YGNodeIsDirty(node))
+    out->append(" dirty");
+  out->push_back('\n');
+  for (uint32_t i = 0; i < YGNodeGetChildCount(node); ++i)
+    DumpYogaNode(YGNodeGetChild(node, i), depth + 1, out);
 }
 
 }  // namespace
@@ -34,17 +58,20 @@ const char View::kClassName[] = "View";
 
 View::View() : view_(nullptr) {
   // Create node with the default yoga config.
-  yoga_config_ = YGConfigNew();
-  YGConfigCopy(yoga_config_, State::GetCurrent()->yoga_config());
+  State* state = State::GetCurrent();
+  yoga_config_ = state->yoga_config();
+  state->yoga_config_cache()->AddRef(yoga_config_);
   node_ = YGNodeNewWithConfig(yoga_config_);
+  YGNodeSetContext(node_, this);
 }
 
 View::~View() {
   PlatformDestroy();
 
-  // Free yoga config and node.
+  // Free yoga node and release the shared config.
   YGNodeFree(node_);
-  YGConfigFree(yoga_config_);
+  if (State::GetCurrent())
+    State::GetCurrent()->yoga_config_cache()->Release(yoga_config_);
 }
 
 const char* View::GetClassName() const {
@@ -66,14 +93,44 @@ void View::Layout() {
 }
 
 void View::UpdateDefaultStyle() {
-  SizeF min_size = GetMinimumSize();
-  YGNodeStyleSetMinWidth(node_, min_size.width());
-  YGNodeStyleSetMinHeight(node_, min_size.height());
+  measurements_.clear();
+  if (YGNodeGetMeasureFunc(node_)) {
+    // The view will be measured when yoga needs its size.
+    YGNodeMarkDirty(node_);
+  } else {
+    SizeF min_size = GetMinimumSize();
+    YGNodeStyleSetMinWidth(node_, min_size.width());
+    YGNodeStyleSetMinHeight(node_, min_size.height());
+  }
   Layout();
 }
 
+SizeF View::GetCachedMeasurement(float width) {
+  for (const auto& m : measurements_) {
+    if (m.first == width)
+      return m.second;
+  }
+  SizeF size = Measure(width);
+  // Usually only the natural size and the size for current width are asked.
+  if (measurements_.size() >= 4)
+    measurements_.erase(measurements_.begin());
+  measurements_.emplace_back(width, size);
+  return size;
+}
+
+void View::UseMeasureFunc() {
+  YGNodeSetMeasureFunc(node_, MeasureView);
+}
+
+void View::SetFont(Font* font) {
+  font_ = font;
+  PlatformSetFont(font);
+  if (YGNodeGetMeasureFunc(node_))
+    UpdateDefaultStyle();
+}
+
 void View::SetStyleProperty(const std::string& name, const std::string& value) {
-  std::string key(ParseName(name));
+  std::string key(ParseStyleName(name));
   if (key == "color")
     SetColor(Color(value));
   else if (key == "backgroundcolor")
@@ -83,7 +140,12 @@ void View::SetStyleProperty(const std::string& name, const std::string& value) {
 }
 
 void View::SetStyleProperty(const std::string& name, float value) {
-  SetYogaProperty(node_, ParseName(name), value);
+  SetYogaProperty(node_, ParseStyleName(name), value);
+}
+
+void View::ApplyStyle(StyleSheet* style) {
+  style->ApplyTo(this);
+  Layout();
 }
 
 void View::PrintStyle() const {
@@ -92,32 +154,96 @@ void View::PrintStyle() const {
                                                  YGPrintOptionsChildren));
 }
 
+std::string View::DumpLayoutTree() const {
+  std::string out;
+  DumpYogaNode(node_, 0, &out);
+  return out;
+}
+
 SizeF View::GetMinimumSize() const {
   return SizeF();
 }
 
+SizeF View::Measure(float width) const {
+  return GetMinimumSize();
+}
+
 void View::SetParent(View* parent) {
+  parent_ = parent;
   if (parent) {
     window_ = parent->window_;
-    YGConfigCopy(yoga_config_, parent->yoga_config_);
+    SetYogaConfig(parent->yoga_config_);
   } else {
     window_ = nullptr;
   }
-  parent_ = parent;
 }
 
 void View::BecomeContentView(Window* window) {
+  parent_ = nullptr;
   if (window) {
     window_ = window;
-    YGConfigCopy(yoga_config_, window->GetYogaConfig());
+    SetYogaConfig(window->GetYogaConfig());
   } else {
     window_ = nullptr;
   }
-  parent_ = nullptr;
 }
 
 void View::OnSizeChanged() {
   on_size_changed.Emit(this);
 }
 
+void View::SetYogaConfig(YGConfigRef config) {
+  // Views share interned configs, so nothing to do when they are the same.
+  if (config == yoga_config_)
+    return;
+
+  // The yoga we use can not change the config of a node after creation, so
+  // create a new node and move the style and children to it.
+  ReplaceYogaNode(config, true);
+
+  YogaConfigCache* cache = State::GetCurrent()->yoga_config_cache();
+  cache->AddRef(config);
+  cache->Release(yoga_config_);
+  yoga_config_ = config;
+}
+
+void View::ReplaceYogaNode(YGConfigRef config, bool keep_children) {
+  YGNodeRef node = YGNodeNewWithConfig(config);
+  YGNodeCopyStyle(node, node_);
+  YGNodeSetContext(node, this);
+  YGNodeSetMeasureFunc(node, YGNodeGetMeasureFunc(node_));
+  std::vector<YGNodeRef> children;
+  if (keep_children) {
+    children.resize(YGNodeGetChildCount(node_));
+    for (size_t i = 0; i < children.size(); ++i)
+      children[i] = YGNodeGetChild(node_, i);
+  }
+
+  // Take the place of old node in parent.
+  YGNodeRef parent = YGNodeGetParent(node_);
+  if (parent) {
+    uint32_t index = 0;
+    while (YGNodeGetChild(parent, index) != node_)
+      ++index;
+    YGNodeRemoveChild(parent, node_);
+    YGNodeInsertChild(parent, node, index);
+  }
+
+  // Freeing the node detaches all its children, which is much cheaper than
+  // removing them one by one since yoga searches the child list for each.
+  YGNodeFree(node_);
+  node_ = node;
+  for (size_t i = 0; i < children.size(); ++i)
+    YGNodeInsertChild(node, children[i], i);
+
+  // The new node has no computed layout, inserting it has marked the parent
+  // dirty so the layout is computed again. The layout being computed on
+  // background thread may refer to the freed node, and must be discarded.
+  View* root = this;
+  while (root->GetParent())
+    root = root->GetParent();
+  if (root->GetWindow())
+    root->GetWindow()->InvalidateAsyncLayout();
+}
+
 }  // namespace nu
@@ -6,6 +6,8 @@
 #define NATIVEUI_VIEW_H_
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "base/memory/ref_counted.h"
 #include "nativeui/gfx/color.h"
@@ -20,6 +22,7 @@ typedef struct YGConfig *YGConfigRef;
 namespace nu {
 
 class Font;
+class StyleSheet;
 class Window;
 struct MouseEvent;
 struct KeyEvent;
@@ -46,6 +49,10 @@ class NATIVEUI_EXPORT View : public base::RefCounted<View> {
   // Get position and size.
   RectF GetBounds() const;
 
+  // Internal: Whether SetBounds(|bounds|) would change the native bounds, the
+  // bounds are compared after being snapped like SetBounds does.
+  bool IsBoundsChangedBy(const RectF& bounds) const;
+
   // Internal: The real pixel bounds that depends on the scale factor.
   void SetPixelBounds(const Rect& bounds);
   Rect GetPixelBounds() const;
@@ -54,7 +61,11 @@ class NATIVEUI_EXPORT View : public base::RefCounted<View> {
   virtual void Layout();
 
   // Mark the whole view as dirty.
-  void SchedulePaint();
+  virtual void SchedulePaint();
+
+  // Mark |rect| of the view as dirty, the dirty areas are accumulated until
+  // next redraw.
+  virtual void SchedulePaintRect(const RectF& rect);
 
   // Show/Hide the view.
   void SetVisible(bool visible);
@@ -89,27 +100,31 @@ class NATIVEUI_EXPORT View : public base::RefCounted<View> {
 
   // Set styles and re-compute the layout.
   template<typename... Args>
-  void SetStyle(const std::string& name, const std::string& value,
-                Args... args) {
-    SetStyleProperty(name, value);
-    SetStyle(args...);
-    Layout();
-  }
-  template<typename... Args>
-  void SetStyle(const std::string& name, float value, Args... args) {
-    SetStyleProperty(name, value);
-    SetStyle(args...);
+  void SetStyle(const std::string& name, Args... args) {
+    SetStyleProperties(name, args...);
     Layout();
   }
-  void SetStyle() {
-  }
+
+  // Set the pre-parsed styles and re-compute the layout.
+  void ApplyStyle(StyleSheet* style);
 
   // Internal: Print style layout to stdout.
   void PrintStyle() const;
 
+  // Return a readable dump of the yoga tree with computed bounds, one line
+  // for each view.
+  std::string DumpLayoutTree() const;
+
   // Return the minimum size of view.
   virtual SizeF GetMinimumSize() const;
 
+  // Internal: Return the size of view when it is given |width|, a negative
+  // |width| means no constraint. Only called for views using measure func.
+  virtual SizeF Measure(float width) const;
+
+  // Internal: Like Measure, but reuse the results until the view changes.
+  SizeF GetCachedMeasurement(float width);
+
   // Get parent.
   View* GetParent() const { return parent_; }
 
@@ -147,15 +162,43 @@ class NATIVEUI_EXPORT View : public base::RefCounted<View> {
   // Update the default style.
   void UpdateDefaultStyle();
 
+  // Let yoga ask for the view's size when computing layout, instead of
+  // setting minimum size in style. Only leaf views can use measure func.
+  void UseMeasureFunc();
+
+  // The font set by SetFont, can be null.
+  Font* font() const { return font_.get(); }
+
+  // The config of view's yoga node.
+  YGConfigRef yoga_config() const { return yoga_config_; }
+
   // Called by subclasses to take the ownership of |view|.
   void TakeOverView(NativeView view);
 
   void PlatformInit();
   void PlatformDestroy();
   void PlatformSetVisible(bool visible);
+  void PlatformSetFont(Font* font);
 
  private:
   friend class base::RefCounted<View>;
+  friend class Container;
+
+  // Set the pairs of styles in arguments without doing layout.
+  template<typename... Args>
+  void SetStyleProperties(const std::string& name, const std::string& value,
+                          Args... args) {
+    SetStyleProperty(name, value);
+    SetStyleProperties(args...);
+  }
+  template<typename... Args>
+  void SetStyleProperties(const std::string& name, float value,
+                          Args... args) {
+    SetStyleProperty(name, value);
+    SetStyleProperties(args...);
+  }
+  void SetStyleProperties() {
+  }
 
   // Relationships.
   View* parent_ = nullptr;
@@ -164,7 +207,15 @@ class NATIVEUI_EXPORT View : public base::RefCounted<View> {
   // The native implementation.
   NativeView view_;
 
-  // The config of its yoga node.
+  // Switch to a different yoga config, which recreates the yoga node.
+  void SetYogaConfig(YGConfigRef config);
+
+  // Create a new yoga node with |config| to take the place of current one. The
+  // children are moved to the new node if |keep_children| is true, otherwise
+  // all of them are detached at once.
+  void ReplaceYogaNode(YGConfigRef config, bool keep_children);
+
+  // The config of its yoga node, shared with other views.
   YGConfigRef yoga_config_;
 
   // The font used for the view.
@@ -175,6 +226,9 @@ class NATIVEUI_EXPORT View : public base::RefCounted<View> {
 
   // Saved state of node's style.
   int node_position_ = 0;
+
+  // Results of GetCachedMeasurement, cleared by UpdateDefaultStyle.
+  std::vector<std::pair<float, SizeF>> measurements_;
 };
 
 }  // namespace nu
@@ -0,0 +1,51 @@
+// Copyright 2017 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <vector>
+
+#include "nativeui/nativeui.h"
+#include "nativeui/test/perf_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/yoga/yoga/Yoga.h"
+
+namespace {
+
+const int kViewCount = 10000;
+
+}  // namespace
+
+class ViewPerfTest : public testing::Test {
+ protected:
+  nu::Lifetime lifetime_;
+  nu::State state_;
+};
+
+TEST_F(ViewPerfTest, SharedYogaConfig) {
+  // The size of one config allocation, which every view used to own.
+  size_t before = nu::GetYogaAllocatedBytes();
+  YGConfigRef config = YGConfigNew();
+  size_t config_size = nu::GetYogaAllocatedBytes() - before;
+  YGConfigFree(config);
+
+  scoped_refptr<nu::Window> window(new nu::Window(nu::Window::Options()));
+  scoped_refptr<nu::Container> container(new nu::Container);
+  window->SetContentView(container.get());
+
+  before = nu::GetYogaAllocatedBytes();
+  size_t configs_before = state_.yoga_config_cache()->size();
+  nu::PerfTimer timer;
+  std::vector<nu::View*> views;
+  views.reserve(kViewCount);
+  for (int i = 0; i < kViewCount; ++i)
+    views.push_back(new nu::Container);
+  container->AddChildViews(views);
+  timer.PrintPerOp("view_create_and_reparent", "shared_config", kViewCount);
+
+  size_t configs = state_.yoga_config_cache()->size() - configs_before;
+  size_t bytes = nu::GetYogaAllocatedBytes() - before;
+  nu::PrintPerfResult("yoga_bytes", "per_10k_views", bytes, "bytes");
+  nu::PrintPerfResult("yoga_config_bytes_saved", "per_10k_views",
+                      (kViewCount - configs) * config_size, "bytes");
+  EXPECT_EQ(configs, 0u);
+}
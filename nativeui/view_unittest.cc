@@ -59,3 +59,34 @@ TEST_F(ViewTest, OnSizeChanged) {
   window->SetContentSize(nu::SizeF(100, 100));
   EXPECT_TRUE(changed);
 }
+
+TEST_F(ViewTest, SharedYogaConfig) {
+  scoped_refptr<nu::Window> window(new nu::Window(nu::Window::Options()));
+  scoped_refptr<nu::Container> container(new nu::Container);
+  window->SetContentView(container.get());
+  for (int i = 0; i < 10; ++i)
+    container->AddChildView(new nu::Label);
+  container->AddChildView(view_.get());
+  EXPECT_EQ(state_.yoga_config_cache()->size(), 1u);
+}
+
+TEST_F(ViewTest, ApplyStyleSheet) {
+  scoped_refptr<nu::Window> window(new nu::Window(nu::Window::Options()));
+  scoped_refptr<nu::Container> container(new nu::Container);
+  window->SetContentView(container.get());
+  window->SetContentSize(nu::SizeF(200, 200));
+  scoped_refptr<nu::StyleSheet> style(new nu::StyleSheet);
+  EXPECT_TRUE(style->SetProperty("flex", 1));
+  EXPECT_TRUE(style->SetProperty("margin-top", "10px"));
+  EXPECT_TRUE(style->SetProperty("marginTop", 20));
+  EXPECT_FALSE(style->SetProperty("unknown", 1));
+  EXPECT_EQ(style->size(), 2u);
+  scoped_refptr<nu::Container> v1(new nu::Container);
+  scoped_refptr<nu::Container> v2(new nu::Container);
+  container->AddChildView(v1.get());
+  container->AddChildView(v2.get());
+  v1->ApplyStyle(style.get());
+  v2->ApplyStyle(style.get());
+  EXPECT_EQ(v1->GetBounds(), nu::RectF(0, 20, 200, 80));
+  EXPECT_EQ(v2->GetBounds(), nu::RectF(0, 120, 200, 80));
+}
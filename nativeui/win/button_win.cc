@@ -222,6 +222,7 @@ class ButtonImpl : public Clickable {
 
 Button::Button(const std::string& title, Type type) {
   TakeOverView(new ButtonImpl(type, this));
+  UseMeasureFunc();
   SetTitle(title);
 }
 
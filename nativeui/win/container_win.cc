@@ -180,8 +180,8 @@ class ContainerAdapter : public ContainerImpl,
     painter->Save();
     painter->ClipRectPixel(Rect(size_allocation().size()));
     float scale_factor = container_->GetNative()->scale_factor();
-    container_->on_draw.Emit(container_, static_cast<Painter*>(painter),
-                             ScaleRect(RectF(dirty), 1.0f / scale_factor));
+    container_->Draw(static_cast<Painter*>(painter),
+                     ScaleRect(RectF(dirty), 1.0f / scale_factor));
     painter->Restore();
   }
 
@@ -209,4 +209,20 @@ void Container::PlatformRemoveChildView(View* child) {
   child->GetNative()->SetParent(nullptr);
 }
 
+void Container::PlatformRemoveAllChildViews() {
+  for (const auto& child : children_)
+    child->GetNative()->SetParent(nullptr);
+}
+
+void Container::PlatformAddChildViews(const std::vector<View*>& views) {
+  NativeView container = GetNative();
+  for (View* child : views)
+    child->GetNative()->SetParent(container);
+}
+
+void Container::PlatformMoveChildView(View* child, int index) {
+  // Painting and hit testing iterate the children of Container, so they
+  // already follow the new order.
+}
+
 }  // namespace nu
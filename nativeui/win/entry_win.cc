@@ -55,6 +55,7 @@ class EntryImpl : public EditView {
 Entry::Entry() {
   auto* edit = new EntryImpl(this);
   TakeOverView(edit);
+  UseMeasureFunc();
   UpdateDefaultStyle();
 }
 
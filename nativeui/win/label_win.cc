@@ -44,6 +44,7 @@ class LabelImpl : public ViewImpl {
 
 Label::Label(const std::string& text) {
   TakeOverView(new LabelImpl(this));
+  UseMeasureFunc();
   SetText(text);
 }
 
@@ -61,7 +62,12 @@ std::string Label::GetText() const {
   return base::UTF16ToUTF8(label->GetText());
 }
 
-SizeF Label::GetMinimumSize() const {
+void Label::PlatformSetWrapping(bool wrap) {
+  // The label is always drawn in one line.
+}
+
+SizeF Label::PlatformMeasure(float width) const {
+  // The label is drawn in one line, so |width| does not matter.
   LabelImpl* label = static_cast<LabelImpl*>(GetNative());
   return ScaleSize(MeasureText(label->GetText(), label->font()),
                    1.0f / GetScaleFactor());
@@ -54,4 +54,9 @@ void Lifetime::PostDelayedTask(int ms, const std::function<void()>& task) {
   tasks_[event] = task;
 }
 
+void Lifetime::PostIdleTask(const std::function<void()>& task) {
+  // There is no idle priority for timers, so just post a normal task.
+  PostTask(task);
+}
+
 }  // namespace nu
@@ -13,7 +13,6 @@
 #include "nativeui/win/util/class_registrar.h"
 #include "nativeui/win/util/gdiplus_holder.h"
 #include "nativeui/win/util/subwin_holder.h"
-#include "third_party/yoga/yoga/Yoga.h"
 
 namespace nu {
 
@@ -69,7 +68,7 @@ void EnableHighDPISupport() {
 void State::PlatformInit() {
   EnableHighDPISupport();
 
-  YGConfigSetPointScaleFactor(yoga_config(), GetScaleFactor());
+  SetYogaScaleFactor(GetScaleFactor());
 
   // Initialize Common Controls.
   INITCOMMONCONTROLSEX config;
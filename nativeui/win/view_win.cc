@@ -250,6 +250,11 @@ RectF View::GetBounds() const {
   return ScaleRect(RectF(GetPixelBounds()), 1.0f / GetNative()->scale_factor());
 }
 
+bool View::IsBoundsChangedBy(const RectF& bounds) const {
+  return GetPixelBounds() !=
+         ToNearestRect(ScaleRect(bounds, GetNative()->scale_factor()));
+}
+
 void View::SetPixelBounds(const Rect& bounds) {
   Rect size_allocation(bounds);
   if (GetParent()) {
@@ -270,6 +275,13 @@ void View::SchedulePaint() {
   GetNative()->Invalidate();
 }
 
+void View::SchedulePaintRect(const RectF& rect) {
+  // The native view expects the area in window pixels.
+  Rect dirty = ToEnclosingRect(ScaleRect(rect, GetNative()->scale_factor()));
+  dirty += GetNative()->size_allocation().OffsetFromOrigin();
+  GetNative()->Invalidate(dirty);
+}
+
 void View::PlatformSetVisible(bool visible) {
   GetNative()->SetVisible(visible);
 }
@@ -317,7 +329,7 @@ bool View::IsMouseDownCanMoveWindow() const {
   return view_->is_draggable();
 }
 
-void View::SetFont(Font* font) {
+void View::PlatformSetFont(Font* font) {
   view_->SetFont(font);
 }
 
@@ -7,12 +7,15 @@
 
 #include <dwmapi.h>
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <memory>
 #include <string>
 #include <tuple>
 
 #include "base/strings/utf_string_conversions.h"
+#include "base/time/time.h"
 #include "base/win/windows_version.h"
 #include "nativeui/accelerator.h"
 #include "nativeui/accelerator_manager.h"
@@ -24,11 +27,11 @@
 #include "nativeui/gfx/win/double_buffer.h"
 #include "nativeui/gfx/win/painter_win.h"
 #include "nativeui/gfx/win/screen_win.h"
+#include "nativeui/lifetime.h"
 #include "nativeui/menu_bar.h"
 #include "nativeui/win/menu_base_win.h"
 #include "nativeui/win/subwin_view.h"
 #include "nativeui/win/util/hwnd_util.h"
-#include "third_party/yoga/yoga/Yoga.h"
 
 namespace nu {
 
@@ -67,6 +70,28 @@ inline bool IsShiftPressed() {
   return (::GetKeyState(VK_SHIFT) & 0x8000) == 0x8000;
 }
 
+// Used when the timing of display is unknown, about 60fps.
+const int kDefaultFrameIntervalMs = 16;
+
+// Return the milliseconds until next vertical blank of the display, so the
+// frames neither drift from nor run faster than the refresh rate.
+int GetDelayToNextVBlank() {
+  DWM_TIMING_INFO info = { sizeof(info) };
+  LARGE_INTEGER frequency, now;
+  if (FAILED(::DwmGetCompositionTimingInfo(nullptr, &info)) ||
+      info.qpcRefreshPeriod == 0 ||
+      !::QueryPerformanceFrequency(&frequency) ||
+      !::QueryPerformanceCounter(&now))
+    return kDefaultFrameIntervalMs;
+  QPC_TIME next = info.qpcVBlank;
+  QPC_TIME current = static_cast<QPC_TIME>(now.QuadPart);
+  if (next <= current)
+    next += ((current - next) / info.qpcRefreshPeriod + 1) *
+            info.qpcRefreshPeriod;
+  double ms = (next - current) * 1000.0 / frequency.QuadPart;
+  return std::max(1, static_cast<int>(std::ceil(ms)));
+}
+
 }  // namespace
 
 WindowImpl::WindowImpl(const Window::Options& options, Window* delegate)
@@ -583,8 +608,7 @@ bool WindowImpl::HasSystemFrame() const {
 void Window::PlatformInit(const Options& options) {
   window_ = new WindowImpl(options, this);
 
-  YGConfigSetPointScaleFactor(yoga_config_,
-                              GetScaleFactorForHWND(window_->hwnd()));
+  SetYogaScaleFactor(GetScaleFactorForHWND(window_->hwnd()));
 }
 
 void Window::PlatformDestroy() {
@@ -711,6 +735,7 @@ bool Window::IsActive() const {
 
 void Window::SetVisible(bool visible) {
   ::ShowWindow(window_->hwnd(), visible ? SW_SHOWNOACTIVATE : SW_HIDE);
+  OnVisibilityChanged();
 }
 
 bool Window::IsVisible() const {
@@ -810,4 +835,26 @@ void Window::PlatformSetMenuBar(MenuBar* menu_bar) {
   ::SetMenu(window_->hwnd(), menu_bar ? menu_bar->GetNative() : NULL);
 }
 
+void Window::PlatformStartFrameClock() {
+  ScheduleFrameTimer(++frame_timer_serial_);
+}
+
+void Window::PlatformStopFrameClock() {
+  // The pending timer is ignored.
+  ++frame_timer_serial_;
+}
+
+void Window::ScheduleFrameTimer(int serial) {
+  base::WeakPtr<Window> weak_ptr = weak_factory_.GetWeakPtr();
+  Lifetime::GetCurrent()->PostDelayedTask(
+      GetDelayToNextVBlank(), [weak_ptr, serial]() {
+        if (!weak_ptr || weak_ptr->frame_timer_serial_ != serial)
+          return;
+        double timestamp =
+            (base::TimeTicks::Now() - base::TimeTicks()).InMillisecondsF();
+        if (weak_ptr->TickFrame(timestamp))
+          weak_ptr->ScheduleFrameTimer(serial);
+      });
+}
+
 }  // namespace nu
@@ -4,8 +4,17 @@
 
 #include "nativeui/window.h"
 
+#include <algorithm>
+
+#include "base/auto_reset.h"
+#include "base/bind.h"
+#include "base/threading/thread.h"
 #include "nativeui/container.h"
+#include "nativeui/gfx/screen.h"
+#include "nativeui/lifetime.h"
 #include "nativeui/menu_bar.h"
+#include "nativeui/state.h"
+#include "nativeui/util/layout_snapshot.h"
 #include "third_party/yoga/yoga/Yoga.h"
 
 #if defined(OS_MACOSX)
@@ -14,10 +23,29 @@
 
 namespace nu {
 
+namespace {
+
+// Runs on the layout thread. The Lifetime outlives the thread, which is
+// stopped when State is destroyed. The |snapshot| is referenced by |reply|,
+// so it is never released on this thread.
+void CalculateLayout(LayoutSnapshot* snapshot,
+                     Lifetime* lifetime,
+                     const Lifetime::Task& reply) {
+  snapshot->Calculate();
+  lifetime->PostTask(reply);
+}
+
+}  // namespace
+
 Window::Window(const Options& options)
     : has_frame_(options.frame),
       transparent_(options.transparent),
-      yoga_config_(YGConfigNew()) {
+      yoga_config_(State::GetCurrent()->yoga_config()),
+      scale_factor_(nu::GetScaleFactor()),
+      weak_factory_(this) {
+  State::GetCurrent()->yoga_config_cache()->AddRef(yoga_config_);
+  on_frame.set_on_connect([this]() { StartFrameClock(); });
+
   // Initialize.
   PlatformInit(options);
   SetContentView(new Container);
@@ -31,6 +59,9 @@ Window::Window(const Options& options)
 
 Window::~Window() {
   PlatformDestroy();
+
+  if (State::GetCurrent())
+    State::GetCurrent()->yoga_config_cache()->Release(yoga_config_);
 }
 
 void Window::SetContentView(View* view) {
@@ -49,10 +80,232 @@ View* Window::GetContentView() const {
   return content_view_.get();
 }
 
+void Window::SetDeferredLayout(bool deferred) {
+  if (deferred_layout_ == deferred)
+    return;
+  deferred_layout_ = deferred;
+  if (!deferred)
+    FlushLayout();
+}
+
+void Window::SetAsyncLayout(bool async) {
+  if (async_layout_ == async)
+    return;
+  async_layout_ = async;
+  if (!async)
+    FlushLayout();
+}
+
+void Window::FlushLayout() {
+  // The layout being computed on background thread is no longer needed.
+  InvalidateAsyncLayout();
+  if (dirty_containers_.empty())
+    return;
+  base::AutoReset<bool> auto_reset(&flushing_layout_, true);
+  std::vector<scoped_refptr<Container>> containers;
+  containers.swap(dirty_containers_);
+
+  // Compute the whole tree once from the root.
+  content_view_->Layout();
+  UpdateDirtyContainers(containers);
+}
+
+void Window::UpdateDirtyContainers(
+    const std::vector<scoped_refptr<Container>>& containers) {
+  std::vector<Container*> roots;
+  for (const auto& container : containers) {
+    if (!container->IsLayoutDirty())
+      continue;
+    // Containers like the content view of Scroll are roots of their own yoga
+    // trees, which are not computed with the window's tree.
+    Container* root = container.get();
+    while (YGNodeGetParent(root->node()))
+      root = static_cast<Container*>(root->GetParent());
+    if (root != content_view_.get() &&
+        std::find(roots.begin(), roots.end(), root) == roots.end()) {
+      roots.push_back(root);
+      root->Layout();
+    }
+    // The containers whose sizes did not change were not updated by their
+    // parents, refresh them now.
+    if (container->IsLayoutDirty())
+      container->SetChildBoundsFromCSS();
+  }
+}
+
+Container* Window::GetContentContainer() const {
+  if (content_view_->GetClassName() != Container::kClassName)
+    return nullptr;
+  return static_cast<Container*>(content_view_.get());
+}
+
+void Window::ScheduleLayout(Container* container) {
+  dirty_containers_.push_back(container);
+  if (layout_scheduled_)
+    return;
+
+  // The frame clock computes the layout right before painting the frame.
+  if (frame_clock_running_ && IsVisible()) {
+    layout_scheduled_ = true;
+    return;
+  }
+
+  PostLayoutTask();
+}
+
+void Window::PostLayoutTask() {
+  // Without an event loop managed by us there is nothing to defer to.
+  Lifetime* lifetime = Lifetime::GetCurrent();
+  if (!lifetime) {
+    FlushLayout();
+    return;
+  }
+
+  layout_scheduled_ = true;
+  scoped_refptr<Window> self(this);
+  lifetime->PostIdleTask([self]() {
+    self->layout_scheduled_ = false;
+    if (self->async_layout_ && Lifetime::kThreadSafePostTask)
+      self->StartAsyncLayout();
+    else
+      self->FlushLayout();
+  });
+}
+
+void Window::RequestFrame() {
+  frame_requested_ = true;
+  StartFrameClock();
+}
+
+bool Window::TickFrame(double timestamp) {
+  // Windows can also be hidden without SetVisible, like being closed.
+  if (!IsVisible()) {
+    OnFrameClockStopped();
+    return false;
+  }
+
+  scoped_refptr<Window> self(this);
+  frame_requested_ = false;
+  on_frame.Emit(this, timestamp);
+
+  // Layout requested since last frame, including the ones by on_frame
+  // handlers, is done once for the frame.
+  if (layout_scheduled_) {
+    layout_scheduled_ = false;
+    if (async_layout_ && Lifetime::kThreadSafePostTask)
+      StartAsyncLayout();
+    else
+      FlushLayout();
+  }
+
+  if (frame_requested_ || !on_frame.IsEmpty())
+    return true;
+  OnFrameClockStopped();
+  return false;
+}
+
+void Window::StartFrameClock() {
+  // Frames are only delivered by an event loop managed by us. Hidden windows
+  // do not receive frames, the clock is started when they are shown.
+  if (frame_clock_running_ || !window_ || !Lifetime::GetCurrent() ||
+      !IsVisible())
+    return;
+  frame_clock_running_ = true;
+  PlatformStartFrameClock();
+}
+
+void Window::OnVisibilityChanged() {
+  if (IsVisible()) {
+    if (frame_requested_ || !on_frame.IsEmpty())
+      StartFrameClock();
+    return;
+  }
+  if (!frame_clock_running_)
+    return;
+  PlatformStopFrameClock();
+  OnFrameClockStopped();
+}
+
+void Window::OnFrameClockStopped() {
+  frame_clock_running_ = false;
+  // The layout waiting for next frame would never happen otherwise.
+  if (layout_scheduled_)
+    PostLayoutTask();
+}
+
+void Window::StartAsyncLayout() {
+  // The pending layout is flushed when the result of the running one, which
+  // is outdated now, is received.
+  if (async_layout_pending_ || dirty_containers_.empty())
+    return;
+
+  // Only containers add children to yoga nodes.
+  Container* root = GetContentContainer();
+  if (!root || YGNodeGetChildCount(root->node()) == 0) {
+    FlushLayout();
+    return;
+  }
+
+  // A reference is passed to the reply, which always runs on the main thread,
+  // so the copied yoga tree is freed where the nodes are created.
+  scoped_refptr<LayoutSnapshot> snapshot_ref = root->CreateLayoutSnapshot();
+  LayoutSnapshot* snapshot = snapshot_ref.get();
+  snapshot->AddRef();
+  async_layout_pending_ = true;
+  int generation = layout_generation_;
+  base::WeakPtr<Window> weak_ptr = weak_factory_.GetWeakPtr();
+  Lifetime::Task reply = [weak_ptr, snapshot, generation]() {
+    scoped_refptr<LayoutSnapshot> ref(snapshot);
+    snapshot->Release();
+    if (weak_ptr)
+      weak_ptr->FinishAsyncLayout(snapshot, generation);
+  };
+  State::GetCurrent()->GetLayoutThread()->task_runner()->PostTask(
+      FROM_HERE,
+      base::Bind(&CalculateLayout, base::Unretained(snapshot),
+                 Lifetime::GetCurrent(), reply));
+}
+
+void Window::FinishAsyncLayout(LayoutSnapshot* snapshot, int generation) {
+  async_layout_pending_ = false;
+  Container* root = GetContentContainer();
+  if (generation != layout_generation_ || !root ||
+      YGNodeGetChildCount(root->node()) == 0) {
+    FlushLayout();
+    return;
+  }
+
+  LayoutStats* stats = State::GetCurrent()->layout_stats();
+  LayoutStats before(*stats);
+  LayoutStats window_before(layout_stats_);
+  base::AutoReset<bool> auto_reset(&flushing_layout_, true);
+  if (!root->AdoptLayoutSnapshot(snapshot)) {
+    FlushLayout();
+    return;
+  }
+  stats->layout_time += snapshot->layout_time();
+  stats->layout_passes++;
+  stats->nodes_visited++;
+  layout_stats_ = window_before;
+  layout_stats_ += *stats - before;
+
+  std::vector<scoped_refptr<Container>> containers;
+  containers.swap(dirty_containers_);
+  UpdateDirtyContainers(containers);
+}
+
 SizeF Window::GetContentSize() const {
   return content_view_->GetBounds().size();
 }
 
+void Window::SetYogaScaleFactor(float scale_factor) {
+  YogaConfigCache* cache = State::GetCurrent()->yoga_config_cache();
+  YGConfigRef config = cache->Acquire(scale_factor);
+  cache->Release(yoga_config_);
+  yoga_config_ = config;
+  scale_factor_ = scale_factor;
+}
+
 #if defined(OS_WIN) || defined(OS_LINUX)
 void Window::SetMenuBar(MenuBar* menu_bar) {
   if (menu_bar_)
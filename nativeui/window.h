@@ -8,10 +8,13 @@
 #include <functional>
 #include <string>
 #include <tuple>
+#include <vector>
 
+#include "base/memory/weak_ptr.h"
 #include "nativeui/container.h"
 #include "nativeui/gfx/color.h"
 #include "nativeui/gfx/geometry/rect_f.h"
+#include "nativeui/layout_stats.h"
 
 #if defined(OS_WIN)
 // Windows headers define macros for these function names which screw with us.
@@ -25,9 +28,11 @@
 
 namespace nu {
 
+class LayoutSnapshot;
 class MenuBar;
 
 #if defined(OS_MACOSX)
+class DisplayLink;
 class Toolbar;
 #endif
 
@@ -112,14 +117,59 @@ class NATIVEUI_EXPORT Window : public base::RefCounted<Window> {
   MenuBar* GetMenuBar() const { return menu_bar_.get(); }
 #endif
 
+  // When enabled, layout requests from children only mark the layout as dirty,
+  // and the layout is computed once for the whole window before next redraw.
+  void SetDeferredLayout(bool deferred);
+  bool IsDeferredLayout() const { return deferred_layout_; }
+
+  // When enabled, the deferred layout is computed on a background thread and
+  // the results are applied to views when ready. The main thread is not
+  // blocked unless the tree changed while computing, in which case the layout
+  // is computed again on the main thread.
+  void SetAsyncLayout(bool async);
+  bool IsAsyncLayout() const { return async_layout_; }
+
+  // Compute the pending layout immediately.
+  void FlushLayout();
+
+  // Return the counters of layout work done in this window since last reset.
+  LayoutStats GetLayoutStats() const { return layout_stats_; }
+  void ResetLayoutStats() { layout_stats_ = LayoutStats(); }
+
+  // Emit on_frame once on next frame of the display. The frame clock keeps
+  // ticking as long as on_frame has listeners.
+  void RequestFrame();
+
   // Get the native window object.
   NativeWindow GetNative() const { return window_; }
 
+  // Internal: Whether layout requests should be deferred now.
+  bool ShouldDeferLayout() const {
+    return (deferred_layout_ || async_layout_) && !flushing_layout_;
+  }
+
+  // Internal: Discard the results of the layout being computed on background
+  // thread, called when the views have been changed.
+  void InvalidateAsyncLayout() { ++layout_generation_; }
+
+  // Internal: Record |container| as needing layout and schedule a flush.
+  void ScheduleLayout(Container* container);
+
+  // Internal: Called by the frame clock, return whether to keep ticking.
+  bool TickFrame(double timestamp);
+
+  // Internal: Return the counters of layout work in this window.
+  LayoutStats* layout_stats() { return &layout_stats_; }
+
   // Internal: Get the yogo config object.
   YGConfigRef GetYogaConfig() const { return yoga_config_; }
 
+  // Internal: Return the scale factor of the screen the window is on.
+  float GetScaleFactor() const { return scale_factor_; }
+
   // Events.
   Signal<void(Window*)> on_close;
+  Signal<void(Window*, double)> on_frame;
 
   // Delegate methods.
   std::function<bool(Window*)> should_close;
@@ -137,6 +187,40 @@ class NATIVEUI_EXPORT Window : public base::RefCounted<Window> {
 #if defined(OS_WIN) || defined(OS_LINUX)
   void PlatformSetMenuBar(MenuBar* menu_bar);
 #endif
+  void PlatformStartFrameClock();
+  void PlatformStopFrameClock();
+
+  // Start calling TickFrame on every frame.
+  void StartFrameClock();
+
+  // Stop the frame clock of hidden windows, and restart it when shown.
+  void OnVisibilityChanged();
+
+  // Called when the frame clock stops ticking.
+  void OnFrameClockStopped();
+
+  // Compute the deferred layout when the event loop is idle.
+  void PostLayoutTask();
+
+#if defined(OS_WIN)
+  // Call TickFrame on next vertical blank, unless the frame clock has been
+  // restarted with a different |serial|.
+  void ScheduleFrameTimer(int serial);
+#endif
+
+  // Compute the deferred layout on background thread.
+  void StartAsyncLayout();
+  void FinishAsyncLayout(LayoutSnapshot* snapshot, int generation);
+
+  // Update the deferred |containers| after the window's tree is computed.
+  void UpdateDirtyContainers(
+      const std::vector<scoped_refptr<Container>>& containers);
+
+  // Return the content view if it is a Container, otherwise null.
+  Container* GetContentContainer() const;
+
+  // Use a yoga config with |scale_factor| for window's children.
+  void SetYogaScaleFactor(float scale_factor);
 
   // Whether window has a native chrome.
   bool has_frame_;
@@ -147,9 +231,35 @@ class NATIVEUI_EXPORT Window : public base::RefCounted<Window> {
   // Whether there is native shadow.
   bool has_shadow_ = false;
 
-  // The yoga config for window's children.
+  // The yoga config for window's children, interned by State.
   YGConfigRef yoga_config_;
 
+  // The scale factor used by |yoga_config_|.
+  float scale_factor_;
+
+  // Deferred layout states.
+  bool deferred_layout_ = false;
+  bool flushing_layout_ = false;
+  bool layout_scheduled_ = false;
+  std::vector<scoped_refptr<Container>> dirty_containers_;
+
+  // Background layout states.
+  bool async_layout_ = false;
+  bool async_layout_pending_ = false;
+  int layout_generation_ = 0;
+
+  // Counters of layout work.
+  LayoutStats layout_stats_;
+
+  // Frame clock states.
+  bool frame_clock_running_ = false;
+  bool frame_requested_ = false;
+#if defined(OS_MACOSX)
+  DisplayLink* display_link_ = nullptr;
+#elif defined(OS_WIN)
+  int frame_timer_serial_ = 0;
+#endif
+
 #if defined(OS_MACOSX)
   scoped_refptr<Toolbar> toolbar_;
 #endif
@@ -160,6 +270,8 @@ class NATIVEUI_EXPORT Window : public base::RefCounted<Window> {
 
   NativeWindow window_ = nullptr;
   scoped_refptr<View> content_view_;
+
+  base::WeakPtrFactory<Window> weak_factory_;
 };
 
 }  // namespace nu
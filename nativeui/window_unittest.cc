@@ -131,3 +131,36 @@ TEST_F(WindowTest, TransparentWindowResizable) {
   window_->SetResizable(true);
   EXPECT_EQ(window_->GetContentSize(), size);
 }
+
+TEST_F(WindowTest, OnFrame) {
+  window_->SetVisible(true);
+  int frames = 0;
+  double last_timestamp = 0;
+  window_->on_frame.Connect([&](nu::Window* window, double timestamp) {
+    EXPECT_GE(timestamp, last_timestamp);
+    last_timestamp = timestamp;
+    if (++frames == 3) {
+      window->on_frame.DisconnectAll();
+      lifetime_.Quit();
+    }
+  });
+  lifetime_.Run();
+  EXPECT_EQ(frames, 3);
+}
+
+TEST_F(WindowTest, LayoutFlushedWhenHidden) {
+  window_->SetContentSize(nu::SizeF(100, 100));
+  window_->SetVisible(true);
+  window_->SetDeferredLayout(true);
+  window_->on_frame.Connect([](nu::Window*, double) {});
+  nu::Container* content =
+      static_cast<nu::Container*>(window_->GetContentView());
+  scoped_refptr<nu::Container> child = new nu::Container;
+  child->SetStyle("flex", 1);
+  child->on_size_changed.Connect([this](nu::View*) { lifetime_.Quit(); });
+  // The layout waits for next frame, which never comes for hidden windows.
+  content->AddChildView(child.get());
+  window_->SetVisible(false);
+  lifetime_.Run();
+  EXPECT_FALSE(content->IsLayoutDirty());
+}
@@ -4,6 +4,7 @@
 
 #include <node.h>
 
+#include "nativeui/gfx/geometry/rect_conversions.h"
 #include "nativeui/nativeui.h"
 #include "node_yue/binding_signal.h"
 #include "node_yue/node_integration.h"
@@ -197,6 +198,22 @@ struct Type<nu::App::ThemeColor> {
   }
 };
 
+template<>
+struct Type<nu::LayoutStats> {
+  static constexpr const char* name = "yue.LayoutStats";
+  static v8::Local<v8::Value> ToV8(v8::Local<v8::Context> context,
+                                   const nu::LayoutStats& stats) {
+    auto obj = v8::Object::New(context->GetIsolate());
+    Set(context, obj,
+        "layoutPasses", stats.layout_passes,
+        "nodesVisited", stats.nodes_visited,
+        "measureCalls", stats.measure_calls,
+        "boundsChanges", stats.bounds_changes,
+        "layoutTime", stats.layout_time.InMillisecondsF());
+    return obj;
+  }
+};
+
 template<>
 struct Type<nu::App> {
   static constexpr const char* name = "yue.App";
@@ -209,7 +226,9 @@ struct Type<nu::App> {
         "setApplicationMenu", &nu::App::SetApplicationMenu,
 #endif
         "getColor", &nu::App::GetColor,
-        "getDefaultFont", &nu::App::GetDefaultFont);
+        "getDefaultFont", &nu::App::GetDefaultFont,
+        "getLayoutStats", &nu::App::GetLayoutStats,
+        "resetLayoutStats", &nu::App::ResetLayoutStats);
   }
 };
 
@@ -312,14 +331,27 @@ struct Type<nu::Font::Style> {
   }
 };
 
+template<>
+struct Type<nu::FontMetrics> {
+  static constexpr const char* name = "yue.FontMetrics";
+  static v8::Local<v8::Value> ToV8(v8::Local<v8::Context> context,
+                                   const nu::FontMetrics& metrics) {
+    v8::Local<v8::Object> obj = v8::Object::New(context->GetIsolate());
+    Set(context, obj,
+        "ascent", metrics.ascent,
+        "descent", metrics.descent,
+        "averageCharWidth", metrics.average_char_width);
+    return obj;
+  }
+};
+
 template<>
 struct Type<nu::Font> {
   static constexpr const char* name = "yue.Font";
   static void BuildConstructor(v8::Local<v8::Context> context,
                                v8::Local<v8::Object> constructor) {
     Set(context, constructor,
-        "create", &CreateOnHeap<nu::Font, const std::string&, float,
-                                nu::Font::Weight, nu::Font::Style>,
+        "create", &Create,
         "default", &GetDefault);
   }
   static void BuildPrototype(v8::Local<v8::Context> context,
@@ -328,13 +360,181 @@ struct Type<nu::Font> {
         "getName", &nu::Font::GetName,
         "getSize", &nu::Font::GetSize,
         "getWeight", &nu::Font::GetWeight,
-        "getStyle", &nu::Font::GetStyle);
+        "getStyle", &nu::Font::GetStyle,
+        "getMetrics", &nu::Font::GetMetrics);
+  }
+  // Fonts with the same specs are shared.
+  static nu::Font* Create(const std::string& name, float size,
+                          nu::Font::Weight weight, nu::Font::Style style) {
+    return nu::State::GetCurrent()->font_registry()->GetFont(
+        name, size, weight, style);
   }
   static nu::Font* GetDefault() {
     return nu::App::GetCurrent()->GetDefaultFont();
   }
 };
 
+template<>
+struct Type<nu::StyleSheet> {
+  static constexpr const char* name = "yue.StyleSheet";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+    Set(context, constructor, "create", &Create);
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+    Set(context, templ,
+        "setProperty", &SetProperty,
+        "size", &nu::StyleSheet::size);
+  }
+  static nu::StyleSheet* Create(
+      const std::map<std::string, v8::Local<v8::Value>>& styles) {
+    nu::StyleSheet* style = new nu::StyleSheet;
+    ReadStyles(styles, style);
+    return style;
+  }
+  static bool SetProperty(nu::StyleSheet* style,
+                          const std::string& name,
+                          v8::Local<v8::Value> value) {
+    if (value->IsNumber())
+      return style->SetProperty(name, value->NumberValue());
+    else
+      return style->SetProperty(name, *v8::String::Utf8Value(value));
+  }
+  // Numbers are passed as numbers instead of strings.
+  static void ReadStyles(
+      const std::map<std::string, v8::Local<v8::Value>>& styles,
+      nu::StyleSheet* style) {
+    for (const auto& it : styles)
+      SetProperty(style, it.first, it.second);
+  }
+};
+
+// Get painter commands from a Float32Array or an ArrayBuffer of floats without
+// copying, or from an array of numbers by copying them into |storage|.
+bool GetPainterCommands(v8::Local<v8::Context> context,
+                        v8::Local<v8::Value> value,
+                        std::vector<float>* storage,
+                        const float** data,
+                        size_t* size) {
+  if (value->IsFloat32Array()) {
+    v8::Local<v8::Float32Array> array = value.As<v8::Float32Array>();
+    v8::ArrayBuffer::Contents contents = array->Buffer()->GetContents();
+    *data = reinterpret_cast<const float*>(
+        static_cast<const char*>(contents.Data()) + array->ByteOffset());
+    *size = array->Length();
+    return true;
+  }
+  if (value->IsArrayBuffer()) {
+    v8::ArrayBuffer::Contents contents =
+        value.As<v8::ArrayBuffer>()->GetContents();
+    if (contents.ByteLength() % sizeof(float) != 0)
+      return false;
+    *data = static_cast<const float*>(contents.Data());
+    *size = contents.ByteLength() / sizeof(float);
+    return true;
+  }
+  if (value->IsArray()) {
+    v8::Local<v8::Array> array = value.As<v8::Array>();
+    storage->resize(array->Length());
+    for (uint32_t i = 0; i < array->Length(); ++i) {
+      v8::Local<v8::Value> item;
+      if (!array->Get(context, i).ToLocal(&item) || !item->IsNumber())
+        return false;
+      (*storage)[i] = static_cast<float>(item->NumberValue());
+    }
+    *data = storage->data();
+    *size = storage->size();
+    return true;
+  }
+  return false;
+}
+
+template<>
+struct Type<nu::PainterCommandBuffer> {
+  static constexpr const char* name = "yue.PainterCommandBuffer";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+    Set(context, constructor,
+        "create", &CreateOnHeap<nu::PainterCommandBuffer>);
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+    Set(context, templ,
+        "append", &Append,
+        "clear", &nu::PainterCommandBuffer::Clear,
+        "size", &nu::PainterCommandBuffer::size);
+  }
+  static void Append(Arguments* args, v8::Local<v8::Value> value) {
+    nu::PainterCommandBuffer* buffer;
+    if (!args->GetHolder(&buffer))
+      return;
+    std::vector<float> storage;
+    const float* data;
+    size_t size;
+    v8::Local<v8::Context> context = args->isolate()->GetCurrentContext();
+    if (!GetPainterCommands(context, value, &storage, &data, &size)) {
+      args->ThrowError("Float32Array, ArrayBuffer or Array");
+      return;
+    }
+    buffer->Append(data, size);
+  }
+};
+
+template<>
+struct Type<nu::Path> {
+  static constexpr const char* name = "yue.Path";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+    Set(context, constructor,
+        "create", &CreateOnHeap<nu::Path>);
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+    Set(context, templ,
+        "moveTo", &nu::Path::MoveTo,
+        "lineTo", &nu::Path::LineTo,
+        "bezierCurveTo", &nu::Path::BezierCurveTo,
+        "arc", &nu::Path::Arc,
+        "rect", &nu::Path::Rect,
+        "closePath", &nu::Path::ClosePath,
+        "clear", &nu::Path::Clear,
+        "getBounds", &nu::Path::GetBounds);
+  }
+};
+
+// The resolver of a promise that is settled by native code.
+using PromiseHandle = std::shared_ptr<v8::Global<v8::Promise::Resolver>>;
+
+bool CreatePromise(v8::Local<v8::Context> context,
+                   v8::Local<v8::Promise>* promise,
+                   PromiseHandle* handle) {
+  v8::Local<v8::Promise::Resolver> resolver;
+  if (!v8::Promise::Resolver::New(context).ToLocal(&resolver))
+    return false;
+  *promise = resolver->GetPromise();
+  *handle = std::make_shared<v8::Global<v8::Promise::Resolver>>(
+      context->GetIsolate(), resolver);
+  return true;
+}
+
+// Native callbacks are not called from JavaScript, so the scopes have to be
+// set up before settling the promise.
+void SettlePromise(
+    v8::Isolate* isolate,
+    const PromiseHandle& handle,
+    const std::function<void(v8::Local<v8::Context>,
+                             v8::Local<v8::Promise::Resolver>)>& settle) {
+  Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  v8::MicrotasksScope script_scope(isolate,
+                                   v8::MicrotasksScope::kRunMicrotasks);
+  v8::Local<v8::Promise::Resolver> resolver = handle->Get(isolate);
+  v8::Local<v8::Context> context = resolver->CreationContext();
+  v8::Context::Scope context_scope(context);
+  settle(context, resolver);
+}
+
 template<>
 struct Type<nu::Canvas> {
   static constexpr const char* name = "yue.Canvas";
@@ -342,14 +542,152 @@ struct Type<nu::Canvas> {
                                v8::Local<v8::Object> constructor) {
     Set(context, constructor,
         "create", &CreateOnHeap<nu::Canvas, const nu::SizeF&, float>,
-        "createForMainScreen", &CreateOnHeap<nu::Canvas, const nu::SizeF&>);
+        "createForMainScreen", &CreateOnHeap<nu::Canvas, const nu::SizeF&>,
+        "createFromPixels", &CreateFromPixels);
+  }
+  // The canvas keeps a reference to |buffer| so the memory is alive, the JS
+  // object may be collected before the canvas.
+  static void CreateFromPixels(Arguments* args,
+                               v8::Local<v8::ArrayBuffer> buffer,
+                               int width, int height, int stride,
+                               float scale_factor) {
+    v8::Local<v8::Context> context = args->isolate()->GetCurrentContext();
+    v8::ArrayBuffer::Contents contents = buffer->GetContents();
+    if (width <= 0 || height <= 0 || stride < width * 4 ||
+        static_cast<size_t>(stride) * height > contents.ByteLength()) {
+      ThrowError(context, "The size of pixels does not match the buffer");
+      return;
+    }
+    nu::Canvas::PixelBuffer pixels;
+    pixels.data = static_cast<uint8_t*>(contents.Data());
+    pixels.width = width;
+    pixels.height = height;
+    pixels.stride = stride;
+    auto handle = std::make_shared<v8::Global<v8::ArrayBuffer>>(
+        args->isolate(), buffer);
+    scoped_refptr<nu::Canvas> canvas = nu::Canvas::CreateFromPixels(
+        pixels, scale_factor, [handle]() { handle->Reset(); });
+    args->Return(ToV8(context, canvas.get()));
   }
   static void BuildPrototype(v8::Local<v8::Context> context,
                              v8::Local<v8::ObjectTemplate> templ) {
     Set(context, templ,
         "getScaleFactor", &nu::Canvas::GetScaleFactor,
         "getPainter", &nu::Canvas::GetPainter,
-        "getSize", &nu::Canvas::GetSize);
+        "getSize", &nu::Canvas::GetSize,
+        "lockPixels", &LockPixels,
+        "unlockPixels", &UnlockPixels,
+        "isPixelsLocked", &nu::Canvas::IsPixelsLocked,
+        "paintAsync", &PaintAsync,
+        "isPainting", &nu::Canvas::IsPainting);
+  }
+  // JavaScript can not run on the worker thread, so the painting is described
+  // by commands, which are copied and validated before painting starts.
+  static void PaintAsync(Arguments* args, v8::Local<v8::Value> value) {
+    nu::Canvas* canvas;
+    if (!args->GetHolder(&canvas))
+      return;
+    v8::Isolate* isolate = args->isolate();
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+    auto commands = std::make_shared<std::vector<float>>();
+    nu::PainterCommandBuffer* buffer;
+    const float* data;
+    size_t size;
+    if (FromV8(context, value, &buffer)) {
+      commands->assign(buffer->data(), buffer->data() + buffer->size());
+    } else if (GetPainterCommands(context, value, commands.get(), &data,
+                                  &size)) {
+      if (data != commands->data())
+        commands->assign(data, data + size);
+    } else {
+      args->ThrowError("PainterCommandBuffer, Float32Array, ArrayBuffer or "
+                       "Array");
+      return;
+    }
+    if (canvas->IsPainting() || canvas->IsPixelsLocked()) {
+      ThrowError(context, "Canvas is being painted or locked");
+      return;
+    }
+    std::string error;
+    if (!nu::PainterCommandBuffer::Validate(commands->data(), commands->size(),
+                                            &error)) {
+      ThrowError(context, error);
+      return;
+    }
+    v8::Local<v8::Promise> promise;
+    PromiseHandle handle;
+    if (!CreatePromise(context, &promise, &handle))
+      return;
+    canvas->PaintAsync([commands](nu::Painter* painter) {
+      std::string error;
+      nu::PainterCommandBuffer::Replay(painter, commands->data(),
+                                       commands->size(), &error);
+    }, [isolate, handle]() {
+      SettlePromise(isolate, handle, [](
+          v8::Local<v8::Context> context,
+          v8::Local<v8::Promise::Resolver> resolver) {
+        resolver->Resolve(context, v8::Undefined(context->GetIsolate()))
+            .IsJust();
+      });
+    });
+    args->Return(promise);
+  }
+  // The pixels are returned as an ArrayBuffer that refers to the memory of
+  // canvas, which is detached when unlocking.
+  static void LockPixels(Arguments* args) {
+    nu::Canvas* canvas;
+    v8::Local<v8::Object> holder;
+    if (!args->GetHolder(&canvas) || !args->GetHolder(&holder))
+      return;
+    v8::Isolate* isolate = args->isolate();
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+    if (canvas->IsPixelsLocked()) {
+      ThrowError(context, "Pixels are already locked");
+      return;
+    }
+    nu::Canvas::PixelBuffer pixels = canvas->LockPixels();
+    v8::Local<v8::ArrayBuffer> buffer = v8::ArrayBuffer::New(
+        isolate, pixels.data, pixels.stride * pixels.height);
+    // The canvas must be alive as long as its memory is referenced.
+    buffer->SetPrivate(context, GetPixelsKey(context), holder);
+    holder->SetPrivate(context, GetPixelsKey(context), buffer);
+    v8::Local<v8::Object> obj = v8::Object::New(isolate);
+    Set(context, obj,
+        "data", buffer,
+        "width", pixels.width,
+        "height", pixels.height,
+        "stride", pixels.stride);
+    args->Return(obj);
+  }
+  static void UnlockPixels(Arguments* args) {
+    nu::Canvas* canvas;
+    v8::Local<v8::Object> holder;
+    if (!args->GetHolder(&canvas) || !args->GetHolder(&holder))
+      return;
+    v8::Local<v8::Context> context = args->isolate()->GetCurrentContext();
+    if (!canvas->IsPixelsLocked()) {
+      ThrowError(context, "Pixels are not locked");
+      return;
+    }
+    nu::RectF dirty;
+    if (args->Length() > 0 && !args->GetNext(&dirty)) {
+      args->ThrowError("RectF");
+      return;
+    }
+    v8::Local<v8::Value> buffer;
+    if (holder->GetPrivate(context, GetPixelsKey(context)).ToLocal(&buffer) &&
+        buffer->IsArrayBuffer()) {
+      buffer.As<v8::ArrayBuffer>()->Neuter();
+      holder->DeletePrivate(context, GetPixelsKey(context));
+    }
+    if (args->Length() > 0)
+      canvas->UnlockPixels(nu::ToEnclosingRect(dirty));
+    else
+      canvas->UnlockPixels();
+  }
+  static v8::Local<v8::Private> GetPixelsKey(v8::Local<v8::Context> context) {
+    return v8::Private::ForApi(context->GetIsolate(),
+                               ToV8Symbol(context, "pixels"));
   }
 };
 
@@ -393,13 +731,95 @@ struct Type<nu::Image> {
   static void BuildConstructor(v8::Local<v8::Context> context,
                                v8::Local<v8::Object> constructor) {
     Set(context, constructor,
-        "createFromPath", &CreateOnHeap<nu::Image, const base::FilePath&>);
+        "createFromPath", &CreateOnHeap<nu::Image, const base::FilePath&>,
+        "createFromPathAsync", &CreateFromPathAsync,
+        "createFromBuffer", &CreateFromBuffer,
+        "createFromBase64", &CreateFromBase64,
+        "createFromMappedFile", &CreateFromMappedFile,
+        "createFromPathAtSize", &CreateFromPathAtSize);
+  }
+  // Accepts Buffer, ArrayBuffer and typed arrays, which are read directly
+  // without copying.
+  static void CreateFromBuffer(Arguments* args, v8::Local<v8::Value> value) {
+    float scale_factor = 1.f;
+    if (args->Length() > 1 && !args->GetNext(&scale_factor)) {
+      args->ThrowError("Number");
+      return;
+    }
+    const char* data;
+    size_t size;
+    if (value->IsArrayBufferView()) {
+      v8::Local<v8::ArrayBufferView> view = value.As<v8::ArrayBufferView>();
+      data = static_cast<const char*>(view->Buffer()->GetContents().Data()) +
+             view->ByteOffset();
+      size = view->ByteLength();
+    } else if (value->IsArrayBuffer()) {
+      v8::ArrayBuffer::Contents contents =
+          value.As<v8::ArrayBuffer>()->GetContents();
+      data = static_cast<const char*>(contents.Data());
+      size = contents.ByteLength();
+    } else {
+      args->ThrowError("Buffer or ArrayBuffer");
+      return;
+    }
+    ReturnDecoded(args, nu::Image::CreateFromBuffer(data, size, scale_factor));
+  }
+  static void CreateFromBase64(Arguments* args, const std::string& data) {
+    float scale_factor = 1.f;
+    if (args->Length() > 1 && !args->GetNext(&scale_factor)) {
+      args->ThrowError("Number");
+      return;
+    }
+    ReturnDecoded(args, nu::Image::CreateFromBase64(data, scale_factor));
+  }
+  static void CreateFromMappedFile(Arguments* args,
+                                   const base::FilePath& path) {
+    ReturnDecoded(args, nu::Image::CreateFromMappedFile(path));
+  }
+  static void CreateFromPathAtSize(Arguments* args,
+                                   const base::FilePath& path,
+                                   const nu::SizeF& size,
+                                   float scale_factor) {
+    ReturnDecoded(args,
+                  nu::Image::CreateFromPathAtSize(path, size, scale_factor));
+  }
+  static void ReturnDecoded(Arguments* args, nu::Image* image) {
+    v8::Local<v8::Context> context = args->isolate()->GetCurrentContext();
+    if (!image) {
+      ThrowError(context, "Failed to decode image");
+      return;
+    }
+    args->Return(ToV8(context, image));
+  }
+  // Return a Promise that is resolved with the decoded image.
+  static void CreateFromPathAsync(Arguments* args, const base::FilePath& path) {
+    v8::Isolate* isolate = args->isolate();
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+    v8::Local<v8::Promise> promise;
+    PromiseHandle handle;
+    if (!CreatePromise(context, &promise, &handle))
+      return;
+    nu::Image::CreateFromPathAsync(path, [isolate, handle](nu::Image* image) {
+      SettlePromise(isolate, handle, [image](
+          v8::Local<v8::Context> context,
+          v8::Local<v8::Promise::Resolver> resolver) {
+        if (image) {
+          resolver->Resolve(context, ToV8(context, image)).IsJust();
+        } else {
+          resolver->Reject(context, v8::Exception::Error(
+              ToV8(context, "Failed to read image").As<v8::String>())).IsJust();
+        }
+      });
+    });
+    args->Return(promise);
   }
   static void BuildPrototype(v8::Local<v8::Context> context,
                              v8::Local<v8::ObjectTemplate> templ) {
     Set(context, templ,
         "getSize", &nu::Image::GetSize,
-        "getScaleFactor", &nu::Image::GetScaleFactor);
+        "getScaleFactor", &nu::Image::GetScaleFactor,
+        "setMipmapped", &nu::Image::SetMipmapped,
+        "isMipmapped", &nu::Image::IsMipmapped);
   }
 };
 
@@ -474,6 +894,7 @@ struct Type<nu::Painter> {
         "rect", &nu::Painter::Rect,
         "clip", &nu::Painter::Clip,
         "clipRect", &nu::Painter::ClipRect,
+        "quickReject", &nu::Painter::QuickReject,
         "translate", &nu::Painter::Translate,
         "rotate", &nu::Painter::Rotate,
         "scale", &nu::Painter::Scale,
@@ -483,10 +904,37 @@ struct Type<nu::Painter> {
         "setLineWidth", &nu::Painter::SetLineWidth,
         "stroke", &nu::Painter::Stroke,
         "fill", &nu::Painter::Fill,
+        "strokePath", &nu::Painter::StrokePath,
+        "fillPath", &nu::Painter::FillPath,
+        "clipPath", &nu::Painter::ClipPath,
         "strokeRect", &nu::Painter::StrokeRect,
         "fillRect", &nu::Painter::FillRect,
         "measureText", &nu::Painter::MeasureText,
-        "drawText", &nu::Painter::DrawText);
+        "drawText", &nu::Painter::DrawText,
+        "execute", &Execute);
+  }
+  static void Execute(Arguments* args, v8::Local<v8::Value> value) {
+    nu::Painter* painter;
+    if (!args->GetHolder(&painter))
+      return;
+    v8::Local<v8::Context> context = args->isolate()->GetCurrentContext();
+    std::string error;
+    nu::PainterCommandBuffer* buffer;
+    std::vector<float> storage;
+    const float* data;
+    size_t size;
+    if (FromV8(context, value, &buffer)) {
+      if (buffer->Replay(painter, &error))
+        return;
+    } else if (GetPainterCommands(context, value, &storage, &data, &size)) {
+      if (nu::PainterCommandBuffer::Replay(painter, data, size, &error))
+        return;
+    } else {
+      args->ThrowError("PainterCommandBuffer, Float32Array, ArrayBuffer or "
+                       "Array");
+      return;
+    }
+    ThrowError(context, error);
   }
 };
 
@@ -1018,9 +1466,18 @@ struct Type<nu::Window> {
 #endif
         "setTitle", &nu::Window::SetTitle,
         "getTitle", &nu::Window::GetTitle,
+        "setDeferredLayout", &nu::Window::SetDeferredLayout,
+        "isDeferredLayout", &nu::Window::IsDeferredLayout,
+        "setAsyncLayout", &nu::Window::SetAsyncLayout,
+        "isAsyncLayout", &nu::Window::IsAsyncLayout,
+        "flushLayout", &nu::Window::FlushLayout,
+        "getLayoutStats", &nu::Window::GetLayoutStats,
+        "resetLayoutStats", &nu::Window::ResetLayoutStats,
+        "requestFrame", &nu::Window::RequestFrame,
         "setBackgroundColor", &nu::Window::SetBackgroundColor);
     SetProperty(context, templ,
                 "onClose", &nu::Window::on_close,
+                "onFrame", &nu::Window::on_frame,
                 "shouldClose", &nu::Window::should_close);
   }
 };
@@ -1040,6 +1497,7 @@ struct Type<nu::View> {
         "getBounds", &nu::View::GetBounds,
         "layout", &nu::View::Layout,
         "schedulePaint", &nu::View::SchedulePaint,
+        "schedulePaintRect", &nu::View::SchedulePaintRect,
         "setVisible", &nu::View::SetVisible,
         "isVisible", &nu::View::IsVisible,
         "focus", &nu::View::Focus,
@@ -1055,7 +1513,9 @@ struct Type<nu::View> {
         "setColor", &nu::View::SetColor,
         "setBackgroundColor", &nu::View::SetBackgroundColor,
         "setStyle", &SetStyle,
+        "applyStyle", &nu::View::ApplyStyle,
         "printStyle", &nu::View::PrintStyle,
+        "dumpLayoutTree", &nu::View::DumpLayoutTree,
         "getMinimumSize", &nu::View::GetMinimumSize,
         "getParent", &nu::View::GetParent,
         "getWindow", &nu::View::GetWindow);
@@ -1076,13 +1536,9 @@ struct Type<nu::View> {
     nu::View* view;
     if (!args->GetHolder(&view))
       return;
-    for (const auto& it : styles) {
-      if (it.second->IsNumber())
-        view->SetStyleProperty(it.first, it.second->NumberValue());
-      else
-        view->SetStyleProperty(it.first, *v8::String::Utf8Value(it.second));
-    }
-    view->Layout();
+    scoped_refptr<nu::StyleSheet> style(new nu::StyleSheet);
+    Type<nu::StyleSheet>::ReadStyles(styles, style.get());
+    view->ApplyStyle(style.get());
   }
 };
 
@@ -1106,11 +1562,25 @@ struct Type<nu::Container> {
         "addChildView", &nu::Container::AddChildView,
         "addChildViewAt", &nu::Container::AddChildViewAt,
         "removeChildView", &nu::Container::RemoveChildView,
+        "addChildViews", &nu::Container::AddChildViews,
+        "removeAllChildViews", &nu::Container::RemoveAllChildViews,
+        "replaceChildViews", &nu::Container::ReplaceChildViews,
+        "moveChildView", &nu::Container::MoveChildView,
+        "beginUpdate", &nu::Container::BeginUpdate,
+        "endUpdate", &nu::Container::EndUpdate,
+        "setCachedDrawing", &nu::Container::SetCachedDrawing,
+        "isCachedDrawing", &nu::Container::IsCachedDrawing,
+        "setTiledDrawing", &nu::Container::SetTiledDrawing,
+        "isTiledDrawing", &nu::Container::IsTiledDrawing,
+        "setTileMemoryLimit", &SetTileMemoryLimit,
         "childCount", &nu::Container::ChildCount,
         "childAt", &nu::Container::ChildAt);
     SetProperty(context, templ,
                 "onDraw", &nu::Container::on_draw);
   }
+  static void SetTileMemoryLimit(nu::Container* container, uint32_t bytes) {
+    container->SetTileMemoryLimit(bytes);
+  }
 };
 
 template<>
@@ -1291,7 +1761,9 @@ struct Type<nu::Label> {
                              v8::Local<v8::ObjectTemplate> templ) {
     Set(context, templ,
         "setText", &nu::Label::SetText,
-        "getText", &nu::Label::GetText);
+        "getText", &nu::Label::GetText,
+        "setWrapping", &nu::Label::SetWrapping,
+        "isWrapping", &nu::Label::IsWrapping);
   }
 };
 
@@ -1567,9 +2039,13 @@ void Initialize(v8::Local<v8::Object> exports) {
           // Classes.
           "App",            vb::Constructor<nu::App>(),
           "Font",           vb::Constructor<nu::Font>(),
+          "StyleSheet",     vb::Constructor<nu::StyleSheet>(),
+          "Canvas",         vb::Constructor<nu::Canvas>(),
           "Color",          vb::Constructor<nu::Color>(),
           "Image",          vb::Constructor<nu::Image>(),
           "Painter",        vb::Constructor<nu::Painter>(),
+          "PainterCommandBuffer", vb::Constructor<nu::PainterCommandBuffer>(),
+          "Path",           vb::Constructor<nu::Path>(),
           "Event",          vb::Constructor<nu::Event>(),
           "FileDialog",     vb::Constructor<nu::FileDialog>(),
           "FileOpenDialog", vb::Constructor<nu::FileOpenDialog>(),
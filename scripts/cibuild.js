@@ -4,7 +4,7 @@
 // Use of this source code is governed by the license that can be found in the
 // LICENSE file.
 
-const {targetCpu, targetOs, execSync} = require('./common')
+const {argv, targetCpu, targetOs, execSync} = require('./common')
 
 const path = require('path')
 
@@ -24,7 +24,12 @@ if (targetOs != 'linux' || targetCpu == 'x64') {
     'lua_unittests',
     'lua_yue_unittests',
   ]
-  execSync(`node ./scripts/build.js out/Component ${tests.join(' ')}`)
+  // Perf tests are always built so they do not rot, but their numbers are
+  // only meaningful on quiet machines, so run them only when asked.
+  const perftests = ['nativeui_perftests']
+  execSync(`node ./scripts/build.js out/Component ${tests.concat(perftests).join(' ')}`)
+  if (argv.includes('--run-perftests'))
+    tests.push(...perftests)
   for (test of tests)
     execSync(`${path.join('out', 'Component', test)}`)
 }
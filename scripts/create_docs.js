@@ -375,6 +375,7 @@ function parseType(lang, str) {
       case 'Dictionary': type.name = 'Object'; break
       case 'Array': type.name = 'Array'; break
       case 'Function': type.name = 'Function'; break
+      case 'Promise': type.name = 'Promise'; break
       case 'std::function': type.name = 'Function'; break
       case 'std::vector': type.name = 'Array'; break
       case 'base::FilePath': type.name = 'String'; break